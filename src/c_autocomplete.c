@@ -5077,12 +5077,17 @@ autocomplete_t autocompletelist[] =
     { "bind z +zoomin",                              DOOM1AND2 },
     { "bind z +zoomout",                             DOOM1AND2 },
     { "bindlist",                                    DOOM1AND2 },
+    { "cachesize ",                                  DOOM1AND2 },
+    { "cachesize 64",                                DOOM1AND2 },
+    { "cachestats",                                  DOOM1AND2 },
     { "centerweapon ",                               DOOM1AND2 },
     { "centerweapon off",                            DOOM1AND2 },
     { "centerweapon on",                             DOOM1AND2 },
     { "clear",                                       DOOM1AND2 },
     { "+clearmark",                                  DOOM1AND2 },
     { "cmdlist ",                                    DOOM1AND2 },
+    { "con_backscroll ",                             DOOM1AND2 },
+    { "con_backscroll 10,000",                       DOOM1AND2 },
     { "con_obituaries ",                             DOOM1AND2 },
     { "con_obituaries off",                          DOOM1AND2 },
     { "con_obituaries on",                           DOOM1AND2 },
@@ -5124,6 +5129,9 @@ autocomplete_t autocompletelist[] =
     { "cvarlist vid_scale*",                         DOOM1AND2 },
     { "cvarlist vid_window*",                        DOOM1AND2 },
     { "cvarlist weapon*",                            DOOM1AND2 },
+    { "dormantmonsters ",                            DOOM1AND2 },
+    { "dormantmonsters off",                         DOOM1AND2 },
+    { "dormantmonsters on",                          DOOM1AND2 },
     { "endgame",                                     DOOM1AND2 },
     { "english ",                                    DOOM1AND2 },
     { "english american",                            DOOM1AND2 },
@@ -5364,11 +5372,17 @@ autocomplete_t autocompletelist[] =
     { "if autouse off then ",                        DOOM1AND2 },
     { "if autouse on ",                              DOOM1AND2 },
     { "if autouse on then ",                         DOOM1AND2 },
+    { "if cachesize ",                               DOOM1AND2 },
+    { "if cachesize 64 ",                            DOOM1AND2 },
+    { "if cachesize 64 then ",                       DOOM1AND2 },
     { "if centerweapon ",                            DOOM1AND2 },
     { "if centerweapon off ",                        DOOM1AND2 },
     { "if centerweapon off then ",                   DOOM1AND2 },
     { "if centerweapon on ",                         DOOM1AND2 },
     { "if centerweapon on then ",                    DOOM1AND2 },
+    { "if con_backscroll ",                          DOOM1AND2 },
+    { "if con_backscroll 10,000 ",                   DOOM1AND2 },
+    { "if con_backscroll 10,000 then ",              DOOM1AND2 },
     { "if con_obituaries ",                          DOOM1AND2 },
     { "if con_obituaries off ",                      DOOM1AND2 },
     { "if con_obituaries off then ",                 DOOM1AND2 },
@@ -5386,6 +5400,11 @@ autocomplete_t autocompletelist[] =
     { "if crosshair on ",                            DOOM1AND2 },
     { "if crosshair on then ",                       DOOM1AND2 },
     { "if crosshaircolor ",                          DOOM1AND2 },
+    { "if dormantmonsters ",                         DOOM1AND2 },
+    { "if dormantmonsters off ",                     DOOM1AND2 },
+    { "if dormantmonsters off then ",                DOOM1AND2 },
+    { "if dormantmonsters on ",                      DOOM1AND2 },
+    { "if dormantmonsters on then ",                 DOOM1AND2 },
     { "if english ",                                 DOOM1AND2 },
     { "if english american ",                        DOOM1AND2 },
     { "if english american then ",                   DOOM1AND2 },
@@ -6538,6 +6557,9 @@ autocomplete_t autocompletelist[] =
     { "map wormhole",                                DOOM2ONLY },
     { "maplist",                                     DOOM1AND2 },
     { "mapstats",                                    DOOM1AND2 },
+    { "memstats",                                    DOOM1AND2 },
+    { "memstats off",                                DOOM1AND2 },
+    { "memstats on",                                 DOOM1AND2 },
     { "maptime",                                     DOOM1AND2 },
     { "+mark",                                       DOOM1AND2 },
     { "+maxzoom",                                    DOOM1AND2 },
@@ -7144,10 +7166,13 @@ autocomplete_t autocompletelist[] =
     { "reset autosave",                              DOOM1AND2 },
     { "reset autotilt",                              DOOM1AND2 },
     { "reset autouse",                               DOOM1AND2 },
+    { "reset cachesize",                             DOOM1AND2 },
     { "reset centerweapon",                          DOOM1AND2 },
+    { "reset con_backscroll",                        DOOM1AND2 },
     { "reset con_obituaries",                        DOOM1AND2 },
     { "reset crosshair",                             DOOM1AND2 },
     { "reset crosshaircolor",                        DOOM1AND2 },
+    { "reset dormantmonsters",                       DOOM1AND2 },
     { "reset english",                               DOOM1AND2 },
     { "reset episode",                               DOOM1ONLY },
     { "reset expansion",                             DOOM2ONLY },
@@ -7561,6 +7586,7 @@ autocomplete_t autocompletelist[] =
     { "toggle centerweapon",                         DOOM1AND2 },
     { "toggle con_obituaries",                       DOOM1AND2 },
     { "toggle crosshair",                            DOOM1AND2 },
+    { "toggle dormantmonsters",                      DOOM1AND2 },
     { "toggle fade",                                 DOOM1AND2 },
     { "toggle flashkeys",                            DOOM1AND2 },
     { "toggle groupmessages",                        DOOM1AND2 },
@@ -68,6 +68,7 @@
 #include "v_video.h"
 #include "version.h"
 #include "w_wad.h"
+#include "z_zone.h"
 
 #define ALIASCMDFORMAT              BOLDITALICS("alias") " [[" BOLD("\"") "]" BOLDITALICS("command") "[" BOLD(";") " " \
                                     BOLDITALICS("command") " ..." BOLD("\"") "]]"
@@ -342,6 +343,7 @@ static bool nightmare_func1(char *cmd, char *parms);
 static bool null_func1(char *cmd, char *parms);
 
 static void bindlist_cmd_func2(char *cmd, char *parms);
+static void cachestats_cmd_func2(char *cmd, char *parms);
 static void clear_cmd_func2(char *cmd, char *parms);
 static void cmdlist_cmd_func2(char *cmd, char *parms);
 static bool condump_cmd_func1(char *cmd, char *parms);
@@ -365,6 +367,7 @@ static void map_cmd_func2(char *cmd, char *parms);
 static void maplist_cmd_func2(char *cmd, char *parms);
 static bool mapstats_cmd_func1(char *cmd, char *parms);
 static void mapstats_cmd_func2(char *cmd, char *parms);
+static void memstats_cmd_func2(char *cmd, char *parms);
 static bool name_cmd_func1(char *cmd, char *parms);
 static void name_cmd_func2(char *cmd, char *parms);
 static void newgame_cmd_func2(char *cmd, char *parms);
@@ -618,12 +621,18 @@ consolecmd_t consolecmds[] =
         "Binds an " BOLDITALICS("+action") " or string of " BOLDITALICS("commands") " to a " BOLDITALICS("control") "."),
     CCMD(bindlist, "", "", null_func1, bindlist_cmd_func2, false, "",
         "Lists all controls bound to an " BOLDITALICS("+action") " or string of commands."),
+    CVAR_INT(cachesize, "", "", int_cvars_func1, int_cvars_func2, CF_NONE, NOVALUEALIAS,
+        "The maximum amount of memory, in megabytes, used to keep lumps cached once they are no longer in use (" BOLD("8") " to " BOLD("1,024") ")."),
+    CCMD(cachestats, "", "", null_func1, cachestats_cmd_func2, false, "",
+        "Shows statistics about the lump cache."),
     CVAR_BOOL(centerweapon, centreweapon, "", bool_cvars_func1, bool_cvars_func2, CF_NONE, BOOLVALUEALIAS,
         "Toggles centering the player's weapon when fired."),
     CCMD(clear, "", "", null_func1, clear_cmd_func2, false, "",
         "Clears the console."),
     CCMD(cmdlist, "", ccmdlist, null_func1, cmdlist_cmd_func2, true, "[" BOLDITALICS("searchstring") "]",
         "Lists all console commands."),
+    CVAR_INT(con_backscroll, "", "", int_cvars_func1, int_cvars_func2, CF_NONE, NOVALUEALIAS,
+        "The maximum number of lines kept in the console (" BOLD("100") " to " BOLD("100,000") ")."),
     CVAR_BOOL(con_obituaries, "", "", bool_cvars_func1, bool_cvars_func2, CF_NONE, BOOLVALUEALIAS,
         "Toggles obituaries in the console when the player or monsters are killed."),
     CCMD(condump, "", "", condump_cmd_func1, condump_cmd_func2, true, "[" BOLDITALICS("filename") "[" BOLD(".txt") "]]",
@@ -634,6 +643,8 @@ consolecmd_t consolecmds[] =
         "The color of the player's crosshair (" BOLD("0") " to " BOLD("255") ")."),
     CCMD(cvarlist, "", "", null_func1, cvarlist_cmd_func2, true, "[" BOLDITALICS("searchstring") "]",
         "Lists all console variables."),
+    CVAR_BOOL(dormantmonsters, "", "", bool_cvars_func1, bool_cvars_func2, CF_NONE, BOOLVALUEALIAS,
+        "Toggles putting idle monsters that can't see the player to sleep until something disturbs them."),
     CCMD(endgame, "", "", game_func1, endgame_cmd_func2, false, "",
         "Ends the game."),
     CVAR_BOOL(english, "", "", english_cvar_func1, english_cvar_func2, CF_NONE, ENGLISHVALUEALIAS,
@@ -746,6 +757,8 @@ consolecmd_t consolecmds[] =
         "The amount of time the player has spent in the current map."),
     CVAR_BOOL(melt, "", "", bool_cvars_func1, bool_cvars_func2, CF_NONE, BOOLVALUEALIAS,
         "Toggles a melting effect when transitioning between some screens."),
+    CCMD(memstats, "", "", null_func1, memstats_cmd_func2, true, "[" BOLD("on") "|" BOLD("off") "]",
+        "Shows statistics about the memory being used, or toggles accounting for it by where it was allocated."),
     CVAR_BOOL(messages, "", "", bool_cvars_func1, bool_cvars_func2, CF_NONE, BOOLVALUEALIAS,
         "Toggles displaying player messages at the top of the screen."),
     CVAR_BOOL(mouselook, "", "", bool_cvars_func1, mouselook_cvar_func2, CF_NONE, BOOLVALUEALIAS,
@@ -1200,19 +1213,139 @@ static void weapon7_action_func(void)
     P_ChangeWeapon(wp_bfg);
 }
 
+//
+// Console command index
+//
+// Every CCMD and CVAR is hashed by its name, alternate spelling and
+// alternate name into an open-addressed table, so that looking up a command
+// doesn't need to walk all of consolecmds[]. Keys that share a name share a
+// probe sequence, and are found in the same order as in consolecmds[].
+//
+#define CONSOLECMDHASHSIZE  1024
+
+typedef struct
+{
+    short   index;
+    short   key;
+} consolecmdhash_t;
+
+static consolecmdhash_t consolecmdhash[CONSOLECMDHASHSIZE];
+static bool             consolecmdhashbuilt;
+
+static const char *C_ConsoleCmdKey(const int index, const int key)
+{
+    return (key == 0 ? consolecmds[index].name : (key == 1 ? consolecmds[index].altspelling : consolecmds[index].alternate));
+}
+
+void C_BuildConsoleCmdIndex(void)
+{
+    int count = 0;
+
+    for (int i = 0; i < CONSOLECMDHASHSIZE; i++)
+        consolecmdhash[i].index = -1;
+
+    for (int i = 0; *consolecmds[i].name; i++)
+        for (int key = 0; key < 3; key++)
+        {
+            const char  *name = C_ConsoleCmdKey(i, key);
+            bool        duplicate = false;
+            int         slot;
+
+            if (!*name || M_StringCompare(name, EMPTYVALUE))
+                continue;
+
+            for (int j = 0; j < key; j++)
+                if (M_StringCompare(name, C_ConsoleCmdKey(i, j)))
+                    duplicate = true;
+
+            if (duplicate)
+                continue;
+
+            if (++count > CONSOLECMDHASHSIZE / 2)
+                I_Error("C_BuildConsoleCmdIndex: Too many console commands.");
+
+            slot = M_StringHash(name) & (CONSOLECMDHASHSIZE - 1);
+
+            while (consolecmdhash[slot].index != -1)
+                slot = (slot + 1) & (CONSOLECMDHASHSIZE - 1);
+
+            consolecmdhash[slot].index = i;
+            consolecmdhash[slot].key = key;
+        }
+
+    consolecmdhashbuilt = true;
+}
+
+int C_FindConsoleCmds(const char *cmd, int *indices, const int maxindices)
+{
+    int count = 0;
+
+    if (!consolecmdhashbuilt)
+        C_BuildConsoleCmdIndex();
+
+    for (int slot = M_StringHash(cmd) & (CONSOLECMDHASHSIZE - 1); consolecmdhash[slot].index != -1;
+        slot = (slot + 1) & (CONSOLECMDHASHSIZE - 1))
+    {
+        const int   i = consolecmdhash[slot].index;
+
+        if (M_StringCompare(cmd, C_ConsoleCmdKey(i, consolecmdhash[slot].key)))
+        {
+            if (count == maxindices)
+                break;
+
+            indices[count++] = i;
+        }
+    }
+
+    return count;
+}
+
 int C_GetIndex(const char *cmd)
 {
-    int i = 0;
+    int indices[CONSOLECMDMATCHESMAX];
+    int count = C_FindConsoleCmds(cmd, indices, CONSOLECMDMATCHESMAX);
 
-    while (*consolecmds[i].name)
+    for (int j = 0; j < count; j++)
     {
+        const int   i = indices[j];
+
         if (M_StringCompare(cmd, consolecmds[i].name) || M_StringCompare(cmd, consolecmds[i].alternate))
-            break;
+            return i;
+    }
 
-        i++;
+    // not found, so return the index of the terminating entry
+    while (*consolecmds[count].name)
+        count++;
+
+    return count;
+}
+
+static int C_GetIndexByName(const char *cmd)
+{
+    int indices[CONSOLECMDMATCHESMAX];
+    int count = C_FindConsoleCmds(cmd, indices, CONSOLECMDMATCHESMAX);
+
+    for (int j = 0; j < count; j++)
+        if (M_StringCompare(cmd, consolecmds[indices[j]].name))
+            return indices[j];
+
+    return -1;
+}
+
+static int C_GetCVARIndex(const char *cmd, const int flags)
+{
+    int indices[CONSOLECMDMATCHESMAX];
+    int count = C_FindConsoleCmds(cmd, indices, CONSOLECMDMATCHESMAX);
+
+    for (int j = 0; j < count; j++)
+    {
+        const int   i = indices[j];
+
+        if (M_StringCompare(cmd, consolecmds[i].name) && consolecmds[i].type == CT_CVAR && (consolecmds[i].flags & flags))
+            return i;
     }
 
-    return i;
+    return -1;
 }
 
 static void C_ShowDescription(int index)
@@ -1453,12 +1586,11 @@ void alias_cmd_func2(char *cmd, char *parms)
 
     M_StripQuotes(parm1);
 
-    for (int i = 0; *consolecmds[i].name; i++)
-        if (M_StringCompare(parm1, consolecmds[i].name))
-        {
-            C_Warning(0, "An alias cannot be the same as an existing CVAR or CCMD.");
-            return;
-        }
+    if (C_GetIndexByName(parm1) != -1)
+    {
+        C_Warning(0, "An alias cannot be the same as an existing CVAR or CCMD.");
+        return;
+    }
 
     if (!*parm2)
     {
@@ -1965,6 +2097,34 @@ static void bindlist_cmd_func2(char *cmd, char *parms)
     }
 }
 
+//
+// cachestats CCMD
+//
+static void cachestats_cmd_func2(char *cmd, char *parms)
+{
+    const int       tabs[3] = { 160, 0, 0 };
+    const uint64_t  lookups = cachestats.hits + cachestats.misses;
+    char            *temp;
+
+    temp = commifystat(cachestats.hits);
+    C_TabbedOutput(tabs, "Hits\t" BOLD("%s") " (%i%%)", temp,
+        (lookups ? (int)(cachestats.hits * 100 / lookups) : 0));
+    free(temp);
+
+    temp = commifystat(cachestats.misses);
+    C_TabbedOutput(tabs, "Misses\t" BOLD("%s") " (%i%%)", temp,
+        (lookups ? (int)(cachestats.misses * 100 / lookups) : 0));
+    free(temp);
+
+    temp = commifystat(cachestats.evictions);
+    C_TabbedOutput(tabs, "Evictions\t" BOLD("%s"), temp);
+    free(temp);
+
+    temp = commify((int64_t)(cachestats.resident >> 10));
+    C_TabbedOutput(tabs, "Resident\t" BOLD("%sKB") " of %iMB", temp, cachesize);
+    free(temp);
+}
+
 //
 // clear CCMD
 //
@@ -2077,12 +2237,16 @@ static void condump_cmd_func2(char *cmd, char *parms)
     {
         char    *temp = commify((int64_t)numconsolestrings - 2);
 
+        // write each line straight from the console's scrollback
         for (int i = 1; i < numconsolestrings - 1; i++)
-            if (console[i].stringtype == dividerstring)
+        {
+            const console_t *line = C_ConsoleLine(i);
+
+            if (line->stringtype == dividerstring)
                 fprintf(file, "%s\n", DIVIDERSTRING);
             else
             {
-                char            *string = M_StringDuplicate(console[i].string);
+                const char      *string = line->string;
                 const int       len = (int)strlen(string);
                 unsigned int    outpos = 0;
                 int             tabcount = 0;
@@ -2090,7 +2254,7 @@ static void condump_cmd_func2(char *cmd, char *parms)
                 if (!len)
                     continue;
 
-                if (console[i].stringtype == warningstring)
+                if (line->stringtype == warningstring)
                     fputs("! ", file);
 
                 for (int inpos = 0; inpos < len; inpos++)
@@ -2099,7 +2263,7 @@ static void condump_cmd_func2(char *cmd, char *parms)
 
                     if (letter == '\t')
                     {
-                        const unsigned int  tabstop = console[i].tabs[tabcount] / 6;
+                        const unsigned int  tabstop = line->tabs[tabcount] / 6;
 
                         if (outpos < tabstop)
                         {
@@ -2125,7 +2289,7 @@ static void condump_cmd_func2(char *cmd, char *parms)
                     }
                 }
 
-                if (console[i].stringtype == playermessagestring)
+                if (line->stringtype == playermessagestring)
                 {
                     char    buffer[9];
 
@@ -2141,8 +2305,8 @@ static void condump_cmd_func2(char *cmd, char *parms)
                 }
 
                 fputc('\n', file);
-                free(string);
             }
+        }
 
         fclose(file);
 
@@ -2989,10 +3153,12 @@ static void if_cmd_func2(char *cmd, char *parms)
     char    parm1[64] = "";
     char    parm2[64] = "";
     char    parm3[128] = "";
+    bool    condition = false;
+    int     i;
 
     if (sscanf(parms, "%63s %63s then %127[^\n]", parm1, parm2, parm3) != 3)
     {
-        const int   i = C_GetIndex(cmd);
+        i = C_GetIndex(cmd);
 
         C_ShowDescription(i);
         C_ShowFormat(i);
@@ -3001,74 +3167,69 @@ static void if_cmd_func2(char *cmd, char *parms)
 
     M_StripQuotes(parm1);
 
-    for (int i = 0; *consolecmds[i].name; i++)
-        if (M_StringCompare(parm1, consolecmds[i].name))
-        {
-            bool    condition = false;
-
-            M_StripQuotes(parm2);
-
-            if (consolecmds[i].type == CT_CVAR)
-            {
-                if (consolecmds[i].flags & (CF_BOOLEAN | CF_INTEGER))
-                {
-                    int value = C_LookupValueFromAlias(parm2, consolecmds[i].aliases);
-
-                    if (value != INT_MIN || sscanf(parms, "%10i", &value) == 1)
-                        condition = (value != INT_MIN && value == *(int *)consolecmds[i].variable);
-                }
-                else if (consolecmds[i].flags & CF_FLOAT)
-                {
-                    float   value = FLT_MIN;
+    if ((i = C_GetIndexByName(parm1)) == -1)
+        return;
 
-                    if (sscanf(parms, "%10f", &value) == 1)
-                        condition = (value != FLT_MIN && value == *(float *)consolecmds[i].variable);
-                }
-                else
-                    condition = M_StringCompare(parm2, *(char **)consolecmds[i].variable);
-            }
-            else if (M_StringCompare(parm1, "fastmonsters"))
-                condition = match(fastparm, parm2);
-            else if (M_StringCompare(parm1, "freeze"))
-                condition = match(freeze, parm2);
-            else if (M_StringCompare(parm1, "god"))
-                condition = match((gamestate == GS_LEVEL && (viewplayer->cheats & CF_GODMODE)), parm2);
-            else if (M_StringCompare(parm1, "noclip"))
-                condition = match((gamestate == GS_LEVEL && (viewplayer->cheats & CF_NOCLIP)), parm2);
-            else if (M_StringCompare(parm1, "nomonsters"))
-                condition = match(nomonsters, parm2);
-            else if (M_StringCompare(parm1, "notarget"))
-                condition = match((gamestate == GS_LEVEL && (viewplayer->cheats & CF_NOTARGET)), parm2);
-            else if (M_StringCompare(parm1, "pistolstart"))
-                condition = match(pistolstart, parm2);
-            else if (M_StringCompare(parm1, "regenhealth"))
-                condition = match(regenhealth, parm2);
-            else if (M_StringCompare(parm1, "respawnitems"))
-                condition = match(respawnitems, parm2);
-            else if (M_StringCompare(parm1, "respawnmonsters"))
-                condition = match(respawnmonsters, parm2);
-            else if (M_StringCompare(parm1, "vanilla"))
-                condition = match(vanilla, parm2);
-
-            if (condition)
-            {
-                char    *strings[255] = { "" };
-                int     j = 0;
+    M_StripQuotes(parm2);
 
-                M_StripQuotes(parm3);
-                strings[0] = strtok(parm3, ";");
+    if (consolecmds[i].type == CT_CVAR)
+    {
+        if (consolecmds[i].flags & (CF_BOOLEAN | CF_INTEGER))
+        {
+            int value = C_LookupValueFromAlias(parm2, consolecmds[i].aliases);
 
-                while (strings[j])
-                {
-                    if (!C_ValidateInput(trimwhitespace(strings[j])))
-                        break;
+            if (value != INT_MIN || sscanf(parms, "%10i", &value) == 1)
+                condition = (value != INT_MIN && value == *(int *)consolecmds[i].variable);
+        }
+        else if (consolecmds[i].flags & CF_FLOAT)
+        {
+            float   value = FLT_MIN;
 
-                    strings[++j] = strtok(NULL, ";");
-                }
-            }
+            if (sscanf(parms, "%10f", &value) == 1)
+                condition = (value != FLT_MIN && value == *(float *)consolecmds[i].variable);
+        }
+        else
+            condition = M_StringCompare(parm2, *(char **)consolecmds[i].variable);
+    }
+    else if (M_StringCompare(parm1, "fastmonsters"))
+        condition = match(fastparm, parm2);
+    else if (M_StringCompare(parm1, "freeze"))
+        condition = match(freeze, parm2);
+    else if (M_StringCompare(parm1, "god"))
+        condition = match((gamestate == GS_LEVEL && (viewplayer->cheats & CF_GODMODE)), parm2);
+    else if (M_StringCompare(parm1, "noclip"))
+        condition = match((gamestate == GS_LEVEL && (viewplayer->cheats & CF_NOCLIP)), parm2);
+    else if (M_StringCompare(parm1, "nomonsters"))
+        condition = match(nomonsters, parm2);
+    else if (M_StringCompare(parm1, "notarget"))
+        condition = match((gamestate == GS_LEVEL && (viewplayer->cheats & CF_NOTARGET)), parm2);
+    else if (M_StringCompare(parm1, "pistolstart"))
+        condition = match(pistolstart, parm2);
+    else if (M_StringCompare(parm1, "regenhealth"))
+        condition = match(regenhealth, parm2);
+    else if (M_StringCompare(parm1, "respawnitems"))
+        condition = match(respawnitems, parm2);
+    else if (M_StringCompare(parm1, "respawnmonsters"))
+        condition = match(respawnmonsters, parm2);
+    else if (M_StringCompare(parm1, "vanilla"))
+        condition = match(vanilla, parm2);
+
+    if (condition)
+    {
+        char    *strings[255] = { "" };
+        int     j = 0;
+
+        M_StripQuotes(parm3);
+        strings[0] = strtok(parm3, ";");
+
+        while (strings[j])
+        {
+            if (!C_ValidateInput(trimwhitespace(strings[j])))
+                break;
 
-            break;
+            strings[++j] = strtok(NULL, ";");
         }
+    }
 }
 
 //
@@ -4903,6 +5064,85 @@ static void mapstats_cmd_func2(char *cmd, char *parms)
     }
 }
 
+//
+// memstats CCMD
+//
+static int C_CompareCallsites(const void *a, const void *b)
+{
+    const zonecallsite_t    *callsite1 = *(const zonecallsite_t **)a;
+    const zonecallsite_t    *callsite2 = *(const zonecallsite_t **)b;
+
+    return (callsite1->bytes < callsite2->bytes) - (callsite1->bytes > callsite2->bytes);
+}
+
+void C_MemStats(void)
+{
+    const int       tabs[3] = { 160, 0, 0 };
+    const char      *tagnames[PU_MAX] = { "", "PU_STATIC", "PU_LEVEL", "PU_LEVSPEC", "PU_CACHE" };
+    zonecallsite_t  *callsites[MAXCALLSITES];
+    int             numcallsites = 0;
+
+    for (int i = PU_STATIC; i < PU_MAX; i++)
+    {
+        char    *temp1 = commify((int64_t)(zonestats[i].bytes >> 10));
+        char    *temp2 = commify(zonestats[i].blocks);
+        char    *temp3 = commify((int64_t)(zonestats[i].peakbytes >> 10));
+
+        C_TabbedOutput(tabs, "%s\t" BOLD("%sKB") " in %s blocks (%sKB at most)", tagnames[i], temp1, temp2, temp3);
+        free(temp1);
+        free(temp2);
+        free(temp3);
+    }
+
+    for (slab_t *slab = slabs; slab; slab = slab->next)
+    {
+        char    *temp1 = commify(slab->live);
+        char    *temp2 = commify(slab->peak);
+
+        C_TabbedOutput(tabs, "%s\t" BOLD("%s") " live (%s at most)", slab->name, temp1, temp2);
+        free(temp1);
+        free(temp2);
+    }
+
+    if (!zoneaccounting)
+        return;
+
+    for (int i = 0; i < MAXCALLSITES; i++)
+        if (zonecallsites[i].bytes)
+            callsites[numcallsites++] = &zonecallsites[i];
+
+    qsort(callsites, numcallsites, sizeof(callsites[0]), &C_CompareCallsites);
+
+    for (int i = 0; i < MIN(numcallsites, 10); i++)
+    {
+        const char  *file = callsites[i]->file;
+        const char  *leaf = (strrchr(file, '/') ? strrchr(file, '/') : strrchr(file, '\\'));
+        char        *temp1 = commify((int64_t)(callsites[i]->bytes >> 10));
+        char        *temp2 = commify(callsites[i]->blocks);
+
+        C_TabbedOutput(tabs, "%s:%i\t" BOLD("%sKB") " in %s %s blocks",
+            (leaf ? leaf + 1 : file), callsites[i]->line, temp1, temp2, tagnames[callsites[i]->tag]);
+        free(temp1);
+        free(temp2);
+    }
+}
+
+static void memstats_cmd_func2(char *cmd, char *parms)
+{
+    if (*parms)
+    {
+        const int   value = C_LookupValueFromAlias(parms, BOOLVALUEALIAS);
+
+        if (value == 0 || value == 1)
+        {
+            zoneaccounting = value;
+            C_Output("Memory is %s being accounted for by where it was allocated.", (zoneaccounting ? "now" : "no longer"));
+        }
+    }
+    else
+        C_MemStats();
+}
+
 //
 // name CCMD
 //
@@ -7942,9 +8182,11 @@ static void timer_cmd_func2(char *cmd, char *parms)
 //
 static void toggle_cmd_func2(char *cmd, char *parms)
 {
+    int i;
+
     if (!*parms)
     {
-        const int   i = C_GetIndex(cmd);
+        i = C_GetIndex(cmd);
 
         C_ShowDescription(i);
         C_ShowFormat(i);
@@ -7953,23 +8195,16 @@ static void toggle_cmd_func2(char *cmd, char *parms)
 
     togglingcvar = true;
 
-    for (int i = 0; *consolecmds[i].name; i++)
+    if ((i = C_GetCVARIndex(parms, CF_BOOLEAN)) != -1 && !(consolecmds[i].flags & CF_READONLY))
     {
-        const int   flags = consolecmds[i].flags;
-
-        if (consolecmds[i].type == CT_CVAR && M_StringCompare(parms, consolecmds[i].name)
-            && !(flags & CF_READONLY) && (flags & CF_BOOLEAN))
-        {
-            char    *temp1 = C_LookupAliasFromValue(!(*(bool *)consolecmds[i].variable), consolecmds[i].aliases);
-            char    *temp2 = M_StringJoin(parms, " ", temp1, NULL);
+        char    *temp1 = C_LookupAliasFromValue(!(*(bool *)consolecmds[i].variable), consolecmds[i].aliases);
+        char    *temp2 = M_StringJoin(parms, " ", temp1, NULL);
 
-            C_ValidateInput(temp2);
-            C_Output("The " BOLD("%s") " CVAR has been toggled " BOLD("%s") ".", parms, temp1);
-            free(temp1);
-            free(temp2);
-            M_SaveCVARs();
-            break;
-        }
+        C_ValidateInput(temp2);
+        C_Output("The " BOLD("%s") " CVAR has been toggled " BOLD("%s") ".", parms, temp1);
+        free(temp1);
+        free(temp2);
+        M_SaveCVARs();
     }
 
     togglingcvar = false;
@@ -8087,42 +8322,41 @@ static bool bool_cvars_func1(char *cmd, char *parms)
 
 static void bool_cvars_func2(char *cmd, char *parms)
 {
-    for (int i = 0; *consolecmds[i].name; i++)
-        if (M_StringCompare(cmd, consolecmds[i].name) && consolecmds[i].type == CT_CVAR && (consolecmds[i].flags & CF_BOOLEAN))
-        {
-            if (*parms && !(consolecmds[i].flags & CF_READONLY))
-            {
-                const int   value = C_LookupValueFromAlias(parms, BOOLVALUEALIAS);
-
-                if ((value == 0 || value == 1) && value != *(bool *)consolecmds[i].variable)
-                {
-                    *(bool *)consolecmds[i].variable = value;
-                    M_SaveCVARs();
-                }
-            }
-            else
-            {
-                char    *temp1 = C_LookupAliasFromValue(*(bool *)consolecmds[i].variable, BOOLVALUEALIAS);
+    const int   i = C_GetCVARIndex(cmd, CF_BOOLEAN);
 
-                C_ShowDescription(i);
+    if (i == -1)
+        return;
 
-                if (*(bool *)consolecmds[i].variable == (bool)consolecmds[i].defaultnumber)
-                    C_Output(INTEGERCVARISDEFAULT, temp1);
-                else
-                {
-                    char    *temp2 = C_LookupAliasFromValue((bool)consolecmds[i].defaultnumber, BOOLVALUEALIAS);
+    if (*parms && !(consolecmds[i].flags & CF_READONLY))
+    {
+        const int   value = C_LookupValueFromAlias(parms, BOOLVALUEALIAS);
 
-                    C_Output(INTEGERCVARWITHDEFAULT, temp1, temp2);
-                    free(temp2);
-                }
+        if ((value == 0 || value == 1) && value != *(bool *)consolecmds[i].variable)
+        {
+            *(bool *)consolecmds[i].variable = value;
+            M_SaveCVARs();
+        }
+    }
+    else
+    {
+        char    *temp1 = C_LookupAliasFromValue(*(bool *)consolecmds[i].variable, BOOLVALUEALIAS);
 
-                C_ShowWarning(i);
+        C_ShowDescription(i);
 
-                free(temp1);
-            }
+        if (*(bool *)consolecmds[i].variable == (bool)consolecmds[i].defaultnumber)
+            C_Output(INTEGERCVARISDEFAULT, temp1);
+        else
+        {
+            char    *temp2 = C_LookupAliasFromValue((bool)consolecmds[i].defaultnumber, BOOLVALUEALIAS);
 
-            break;
+            C_Output(INTEGERCVARWITHDEFAULT, temp1, temp2);
+            free(temp2);
         }
+
+        C_ShowWarning(i);
+
+        free(temp1);
+    }
 }
 
 //
@@ -8141,62 +8375,58 @@ static void color_cvars_func2(char *cmd, char *parms)
 //
 static bool float_cvars_func1(char *cmd, char *parms)
 {
+    float   value;
+
     if (!*parms)
         return true;
 
-    for (int i = 0; *consolecmds[i].name; i++)
-        if (M_StringCompare(cmd, consolecmds[i].name) && consolecmds[i].type == CT_CVAR && (consolecmds[i].flags & CF_FLOAT))
-        {
-            float   value;
-
-            M_StringReplaceAll(parms, ",", "", false);
+    if (C_GetCVARIndex(cmd, CF_FLOAT) == -1)
+        return false;
 
-            return (sscanf(parms, "%10f", &value) == 1);
-        }
+    M_StringReplaceAll(parms, ",", "", false);
 
-    return false;
+    return (sscanf(parms, "%10f", &value) == 1);
 }
 
 static void float_cvars_func2(char *cmd, char *parms)
 {
-    for (int i = 0; *consolecmds[i].name; i++)
-        if (M_StringCompare(cmd, consolecmds[i].name) && consolecmds[i].type == CT_CVAR && (consolecmds[i].flags & CF_FLOAT))
-        {
-            if (*parms && !(consolecmds[i].flags & CF_READONLY))
-            {
-                float   value;
-
-                M_StringReplaceAll(parms, ",", "", false);
+    const int   i = C_GetCVARIndex(cmd, CF_FLOAT);
 
-                if (sscanf(parms, "%10f", &value) == 1 && value != *(float *)consolecmds[i].variable)
-                {
-                    *(float *)consolecmds[i].variable = value;
-                    M_SaveCVARs();
-                }
-            }
-            else
-            {
-                char    *temp1 = striptrailingzero(*(float *)consolecmds[i].variable, 1);
+    if (i == -1)
+        return;
 
-                C_ShowDescription(i);
+    if (*parms && !(consolecmds[i].flags & CF_READONLY))
+    {
+        float   value;
 
-                if (*(float *)consolecmds[i].variable == (float)consolecmds[i].defaultnumber)
-                    C_Output(((consolecmds[i].flags & CF_READONLY) ? INTEGERCVARWITHNODEFAULT : INTEGERCVARISDEFAULT), temp1);
-                else
-                {
-                    char    *temp2 = striptrailingzero(consolecmds[i].defaultnumber, 1);
+        M_StringReplaceAll(parms, ",", "", false);
 
-                    C_Output(((consolecmds[i].flags & CF_READONLY) ? INTEGERCVARWITHNODEFAULT : INTEGERCVARWITHDEFAULT), temp1, temp2);
-                    free(temp2);
-                }
+        if (sscanf(parms, "%10f", &value) == 1 && value != *(float *)consolecmds[i].variable)
+        {
+            *(float *)consolecmds[i].variable = value;
+            M_SaveCVARs();
+        }
+    }
+    else
+    {
+        char    *temp1 = striptrailingzero(*(float *)consolecmds[i].variable, 1);
 
-                free(temp1);
+        C_ShowDescription(i);
 
-                C_ShowWarning(i);
-            }
+        if (*(float *)consolecmds[i].variable == (float)consolecmds[i].defaultnumber)
+            C_Output(((consolecmds[i].flags & CF_READONLY) ? INTEGERCVARWITHNODEFAULT : INTEGERCVARISDEFAULT), temp1);
+        else
+        {
+            char    *temp2 = striptrailingzero(consolecmds[i].defaultnumber, 1);
 
-            break;
+            C_Output(((consolecmds[i].flags & CF_READONLY) ? INTEGERCVARWITHNODEFAULT : INTEGERCVARWITHDEFAULT), temp1, temp2);
+            free(temp2);
         }
+
+        free(temp1);
+
+        C_ShowWarning(i);
+    }
 }
 
 //
@@ -8204,82 +8434,80 @@ static void float_cvars_func2(char *cmd, char *parms)
 //
 static bool int_cvars_func1(char *cmd, char *parms)
 {
+    int i;
+    int value;
+
     if (!*parms)
         return true;
 
-    for (int i = 0; *consolecmds[i].name; i++)
-        if (M_StringCompare(cmd, consolecmds[i].name) && consolecmds[i].type == CT_CVAR && (consolecmds[i].flags & CF_INTEGER))
-        {
-            int value = C_LookupValueFromAlias(parms, consolecmds[i].aliases);
-
-            M_StringReplaceAll(parms, ",", "", false);
+    if ((i = C_GetCVARIndex(cmd, CF_INTEGER)) == -1)
+        return false;
 
-            return ((value != INT_MIN || sscanf(parms, "%10i", &value) == 1)
-                && value >= consolecmds[i].minimumvalue && value <= consolecmds[i].maximumvalue);
-        }
+    value = C_LookupValueFromAlias(parms, consolecmds[i].aliases);
+    M_StringReplaceAll(parms, ",", "", false);
 
-    return false;
+    return ((value != INT_MIN || sscanf(parms, "%10i", &value) == 1)
+        && value >= consolecmds[i].minimumvalue && value <= consolecmds[i].maximumvalue);
 }
 
 static void int_cvars_func2(char *cmd, char *parms)
 {
-    for (int i = 0; *consolecmds[i].name; i++)
-        if (M_StringCompare(cmd, consolecmds[i].name) && consolecmds[i].type == CT_CVAR && (consolecmds[i].flags & CF_INTEGER))
-        {
-            if (*parms && !(consolecmds[i].flags & CF_READONLY))
-            {
-                int value = C_LookupValueFromAlias(parms, consolecmds[i].aliases);
+    const int   i = C_GetCVARIndex(cmd, CF_INTEGER);
 
-                M_StringReplaceAll(parms, ",", "", false);
+    if (i == -1)
+        return;
 
-                if ((value != INT_MIN || sscanf(parms, "%10i", &value) == 1) && value != *(int *)consolecmds[i].variable)
-                {
-                    *(int *)consolecmds[i].variable = value;
-                    M_SaveCVARs();
-                }
-            }
-            else
-            {
-                C_ShowDescription(i);
+    if (*parms && !(consolecmds[i].flags & CF_READONLY))
+    {
+        int value = C_LookupValueFromAlias(parms, consolecmds[i].aliases);
 
-                if (consolecmds[i].flags & CF_PERCENT)
-                {
-                    char    *temp1 = commify(*(int *)consolecmds[i].variable);
+        M_StringReplaceAll(parms, ",", "", false);
 
-                    if (*(int *)consolecmds[i].variable == (int)consolecmds[i].defaultnumber)
-                        C_Output(PERCENTCVARISDEFAULT, temp1);
-                    else
-                    {
-                        char    *temp2 = commify((int)consolecmds[i].defaultnumber);
+        if ((value != INT_MIN || sscanf(parms, "%10i", &value) == 1) && value != *(int *)consolecmds[i].variable)
+        {
+            *(int *)consolecmds[i].variable = value;
+            M_SaveCVARs();
+        }
+    }
+    else
+    {
+        C_ShowDescription(i);
 
-                        C_Output(PERCENTCVARWITHDEFAULT, temp1, temp2);
-                        free(temp2);
-                    }
+        if (consolecmds[i].flags & CF_PERCENT)
+        {
+            char    *temp1 = commify(*(int *)consolecmds[i].variable);
 
-                    free(temp1);
-                }
-                else
-                {
-                    char    *temp1 = C_LookupAliasFromValue(*(int *)consolecmds[i].variable, consolecmds[i].aliases);
+            if (*(int *)consolecmds[i].variable == (int)consolecmds[i].defaultnumber)
+                C_Output(PERCENTCVARISDEFAULT, temp1);
+            else
+            {
+                char    *temp2 = commify((int)consolecmds[i].defaultnumber);
 
-                    if (*(int *)consolecmds[i].variable == (int)consolecmds[i].defaultnumber)
-                        C_Output(((consolecmds[i].flags & CF_READONLY) ? INTEGERCVARWITHNODEFAULT : INTEGERCVARISDEFAULT), temp1);
-                    else
-                    {
-                        char    *temp2 = C_LookupAliasFromValue((int)consolecmds[i].defaultnumber, consolecmds[i].aliases);
+                C_Output(PERCENTCVARWITHDEFAULT, temp1, temp2);
+                free(temp2);
+            }
 
-                        C_Output(((consolecmds[i].flags & CF_READONLY) ? INTEGERCVARWITHNODEFAULT : INTEGERCVARWITHDEFAULT), temp1, temp2);
-                        free(temp2);
-                    }
+            free(temp1);
+        }
+        else
+        {
+            char    *temp1 = C_LookupAliasFromValue(*(int *)consolecmds[i].variable, consolecmds[i].aliases);
 
-                    free(temp1);
-                }
+            if (*(int *)consolecmds[i].variable == (int)consolecmds[i].defaultnumber)
+                C_Output(((consolecmds[i].flags & CF_READONLY) ? INTEGERCVARWITHNODEFAULT : INTEGERCVARISDEFAULT), temp1);
+            else
+            {
+                char    *temp2 = C_LookupAliasFromValue((int)consolecmds[i].defaultnumber, consolecmds[i].aliases);
 
-                C_ShowWarning(i);
+                C_Output(((consolecmds[i].flags & CF_READONLY) ? INTEGERCVARWITHNODEFAULT : INTEGERCVARWITHDEFAULT), temp1, temp2);
+                free(temp2);
             }
 
-            break;
+            free(temp1);
         }
+
+        C_ShowWarning(i);
+    }
 }
 
 //
@@ -8287,41 +8515,40 @@ static void int_cvars_func2(char *cmd, char *parms)
 //
 static void str_cvars_func2(char *cmd, char *parms)
 {
-    for (int i = 0; *consolecmds[i].name; i++)
-        if (M_StringCompare(cmd, consolecmds[i].name) && consolecmds[i].type == CT_CVAR && (consolecmds[i].flags & CF_STRING))
-        {
-            if (M_StringCompare(parms, EMPTYVALUE) && **(char **)consolecmds[i].variable && !(consolecmds[i].flags & CF_READONLY))
-            {
-                *(char **)consolecmds[i].variable = "";
-                M_SaveCVARs();
-            }
-            else if (*parms)
-            {
-                if (!M_StringCompare(parms, *(char **)consolecmds[i].variable) && !(consolecmds[i].flags & CF_READONLY))
-                {
-                    *(char **)consolecmds[i].variable = M_StringDuplicate(parms);
-                    M_StripQuotes(*(char **)consolecmds[i].variable);
-                    M_SaveCVARs();
-                }
-            }
-            else
-            {
-                C_ShowDescription(i);
-
-                if (consolecmds[i].flags & CF_READONLY)
-                    C_Output(STRINGCVARWITHNODEFAULT,
-                        (M_StringCompare(consolecmds[i].name, "version") ? "" : "\""), *(char **)consolecmds[i].variable,
-                        (M_StringCompare(consolecmds[i].name, "version") ? "" : "\""));
-                else if (M_StringCompare(*(char **)consolecmds[i].variable, consolecmds[i].defaultstring))
-                    C_Output(STRINGCVARISDEFAULT, *(char **)consolecmds[i].variable);
-                else
-                    C_Output(STRINGCVARWITHDEFAULT, *(char **)consolecmds[i].variable, consolecmds[i].defaultstring);
+    const int   i = C_GetCVARIndex(cmd, CF_STRING);
 
-                C_ShowWarning(i);
-            }
+    if (i == -1)
+        return;
 
-            break;
+    if (M_StringCompare(parms, EMPTYVALUE) && **(char **)consolecmds[i].variable && !(consolecmds[i].flags & CF_READONLY))
+    {
+        *(char **)consolecmds[i].variable = "";
+        M_SaveCVARs();
+    }
+    else if (*parms)
+    {
+        if (!M_StringCompare(parms, *(char **)consolecmds[i].variable) && !(consolecmds[i].flags & CF_READONLY))
+        {
+            *(char **)consolecmds[i].variable = M_StringDuplicate(parms);
+            M_StripQuotes(*(char **)consolecmds[i].variable);
+            M_SaveCVARs();
         }
+    }
+    else
+    {
+        C_ShowDescription(i);
+
+        if (consolecmds[i].flags & CF_READONLY)
+            C_Output(STRINGCVARWITHNODEFAULT,
+                (M_StringCompare(consolecmds[i].name, "version") ? "" : "\""), *(char **)consolecmds[i].variable,
+                (M_StringCompare(consolecmds[i].name, "version") ? "" : "\""));
+        else if (M_StringCompare(*(char **)consolecmds[i].variable, consolecmds[i].defaultstring))
+            C_Output(STRINGCVARISDEFAULT, *(char **)consolecmds[i].variable);
+        else
+            C_Output(STRINGCVARWITHDEFAULT, *(char **)consolecmds[i].variable, consolecmds[i].defaultstring);
+
+        C_ShowWarning(i);
+    }
 }
 
 //
@@ -8329,24 +8556,28 @@ static void str_cvars_func2(char *cmd, char *parms)
 //
 static void time_cvars_func2(char *cmd, char *parms)
 {
-    for (int i = 0; *consolecmds[i].name; i++)
-        if (M_StringCompare(cmd, consolecmds[i].name) && consolecmds[i].type == CT_CVAR && (consolecmds[i].flags & CF_TIME))
-        {
-            int         tics = *(int *)consolecmds[i].variable / TICRATE;
-            const int   hours = tics / 3600;
-            const int   minutes = ((tics %= 3600)) / 60;
-            const int   seconds = tics % 60;
+    const int   i = C_GetCVARIndex(cmd, CF_TIME);
+    int         tics;
+    int         hours;
+    int         minutes;
+    int         seconds;
 
-            C_ShowDescription(i);
+    if (i == -1)
+        return;
 
-            if (hours)
-                C_Output(TIMECVARWITHNODEFAULT2, hours, minutes, seconds);
-            else
-                C_Output(TIMECVARWITHNODEFAULT1, minutes, seconds);
+    tics = *(int *)consolecmds[i].variable / TICRATE;
+    hours = tics / 3600;
+    minutes = (tics %= 3600) / 60;
+    seconds = tics % 60;
 
-            C_ShowWarning(i);
-            break;
-        }
+    C_ShowDescription(i);
+
+    if (hours)
+        C_Output(TIMECVARWITHNODEFAULT2, hours, minutes, seconds);
+    else
+        C_Output(TIMECVARWITHNODEFAULT1, minutes, seconds);
+
+    C_ShowWarning(i);
 }
 
 //
@@ -8658,6 +8889,7 @@ static void english_cvar_func2(char *cmd, char *parms)
             ST_InitStatBar();
             D_TranslateDehStrings();
             M_TranslateAutocomplete();
+            C_BuildAutocompleteIndex();
             M_SaveCVARs();
         }
     }
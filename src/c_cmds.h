@@ -38,7 +38,8 @@
 #include "doomtype.h"
 #include "m_config.h"
 
-#define MAXALIASES          256
+#define MAXALIASES              256
+#define CONSOLECMDMATCHESMAX    16
 
 #define DIVIDERSTRING       "----------------------------------------------------------------------------------------------------"
 
@@ -143,6 +144,9 @@ void bind_cmd_func2(char *cmd, char *parms);
 void exec_cmd_func2(char *cmd, char *parms);
 
 char *C_LookupAliasFromValue(const int value, const valuealiastype_t valuealiastype);
+void C_BuildConsoleCmdIndex(void);
+int C_FindConsoleCmds(const char *cmd, int *indices, const int maxindices);
 int C_GetIndex(const char *cmd);
 bool C_ExecuteAlias(const char *alias);
+void C_MemStats(void);
 char *C_DistanceTraveled(uint64_t value, bool allowzero);
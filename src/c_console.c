@@ -54,6 +54,7 @@
 #include "m_menu.h"
 #include "m_misc.h"
 #include "p_spec.h"
+#include "p_tick.h"
 #include "s_sound.h"
 #include "SDL_image.h"
 #include "SDL_mixer.h"
@@ -62,7 +63,7 @@
 #include "version.h"
 #include "w_wad.h"
 
-console_t               *console = NULL;
+static console_t        *console;
 
 bool                    consoleactive = false;
 int                     consoleheight = 0;
@@ -153,6 +154,146 @@ bool                    scrollbardrawn;
 
 static void (*consoletextfunc)(int, int, patch_t *, int, int, int, bool, const byte *);
 
+//
+// Console scrollback
+//
+// The scrollback is a ring of at most con_backscroll lines, preceded by
+// CONSOLEBLANKLINES blank lines that are never evicted. Each line's string
+// lives in a single byte pool that is filled and emptied in the same FIFO
+// order as the ring, so adding a line never allocates and the oldest lines
+// are dropped once either the ring or the pool is full.
+//
+static console_t        consoleblankline;
+static int              consolestart;
+
+static char             *consolepool;
+static size_t           consolepoolsize;
+static size_t           consolepooltail;
+
+console_t *C_ConsoleLine(const int index)
+{
+    if (index < CONSOLEBLANKLINES)
+        return &consoleblankline;
+
+    return &console[(consolestart + index - CONSOLEBLANKLINES) % consolestringsmax];
+}
+
+static void C_RemoveOldestConsoleString(void)
+{
+    consolestart = (consolestart + 1) % consolestringsmax;
+    numconsolestrings--;
+
+    if (outputhistory > CONSOLEBLANKLINES)
+        outputhistory--;
+
+    if (inputhistory != -1 && --inputhistory < CONSOLEBLANKLINES)
+        inputhistory = -1;
+}
+
+static char *C_AllocConsoleString(const size_t size)
+{
+    char    *string;
+
+    while (numconsolestrings > CONSOLEBLANKLINES)
+    {
+        const size_t    head = console[consolestart].string - consolepool;
+
+        if (consolepooltail >= head)
+        {
+            if (consolepoolsize - consolepooltail >= size)
+                break;
+
+            if (size < head)
+            {
+                consolepooltail = 0;
+                break;
+            }
+        }
+        else if (head - consolepooltail > size)
+            break;
+
+        C_RemoveOldestConsoleString();
+    }
+
+    if (numconsolestrings == CONSOLEBLANKLINES)
+        consolepooltail = 0;
+
+    string = consolepool + consolepooltail;
+    consolepooltail += size;
+    return string;
+}
+
+static console_t *C_AddConsoleString(const char *string, const stringtype_t stringtype);
+
+static void C_ResizeConsole(void)
+{
+    console_t       *oldconsole = console;
+    char            *oldpool = consolepool;
+    const int       oldstart = consolestart;
+    const size_t    oldstringsmax = consolestringsmax;
+    const int       numstrings = numconsolestrings - CONSOLEBLANKLINES;
+
+    consolestringsmax = con_backscroll;
+    console = I_Realloc(NULL, consolestringsmax * sizeof(*console));
+    consolepoolsize = MAX(consolestringsmax * CONSOLEPOOLBYTESPERSTRING, CONSOLETEXTMAXLENGTH * 2);
+    consolepool = I_Realloc(NULL, consolepoolsize);
+
+    consolestart = 0;
+    consolepooltail = 0;
+    numconsolestrings = CONSOLEBLANKLINES;
+    inputhistory = -1;
+    outputhistory = -1;
+
+    // keep the newest lines that still fit
+    for (int i = MAX(0, numstrings - (int)consolestringsmax); i < numstrings; i++)
+    {
+        const console_t *oldline = &oldconsole[(oldstart + i) % oldstringsmax];
+        console_t       *line = C_AddConsoleString(oldline->string, oldline->stringtype);
+        char            *newstring = line->string;
+
+        *line = *oldline;
+        line->string = newstring;
+    }
+
+    free(oldconsole);
+    free(oldpool);
+}
+
+static console_t *C_AddConsoleString(const char *string, const stringtype_t stringtype)
+{
+    const size_t    size = strlen(string) + 1;
+    char            *newstring;
+    console_t       *line;
+
+    if (consolestringsmax != (size_t)con_backscroll)
+        C_ResizeConsole();
+
+    if (numconsolestrings - CONSOLEBLANKLINES >= (int)consolestringsmax)
+        C_RemoveOldestConsoleString();
+
+    newstring = memcpy(C_AllocConsoleString(size), string, size);
+    line = &console[(consolestart + numconsolestrings++ - CONSOLEBLANKLINES) % consolestringsmax];
+    memset(line, 0, sizeof(*line));
+    line->string = newstring;
+    line->stringtype = stringtype;
+    return line;
+}
+
+static void C_ReplaceLastConsoleString(const char *string)
+{
+    console_t   line = *C_ConsoleLine(numconsolestrings - 1);
+    console_t   *newline;
+
+    // the last line's string is always the newest in the pool
+    consolepooltail = line.string - consolepool;
+    numconsolestrings--;
+
+    newline = C_AddConsoleString(string, line.stringtype);
+    line.string = newline->string;
+    line.wrap = 0;
+    *newline = line;
+}
+
 void C_Input(const char *string, ...)
 {
     va_list args;
@@ -165,13 +306,7 @@ void C_Input(const char *string, ...)
     M_vsnprintf(buffer, CONSOLETEXTMAXLENGTH - 1, string, args);
     va_end(args);
 
-    if (numconsolestrings >= (int)consolestringsmax)
-        console = I_Realloc(console, (consolestringsmax += CONSOLESTRINGSMAX) * sizeof(*console));
-
-    M_StringCopy(console[numconsolestrings].string, buffer, sizeof(console[0].string));
-    console[numconsolestrings].indent = 0;
-    console[numconsolestrings].wrap = 0;
-    console[numconsolestrings++].stringtype = inputstring;
+    C_AddConsoleString(buffer, inputstring);
     inputhistory = -1;
     outputhistory = -1;
     consoleinput[0] = '\0';
@@ -190,13 +325,7 @@ void C_Cheat(const char *string)
 
     buffer[len] = '\0';
 
-    if (numconsolestrings >= (int)consolestringsmax)
-        console = I_Realloc(console, (consolestringsmax += CONSOLESTRINGSMAX) * sizeof(*console));
-
-    M_StringCopy(console[numconsolestrings].string, buffer, sizeof(console[0].string));
-    console[numconsolestrings].indent = 0;
-    console[numconsolestrings].wrap = 0;
-    console[numconsolestrings++].stringtype = cheatstring;
+    C_AddConsoleString(buffer, cheatstring);
     inputhistory = -1;
     outputhistory = -1;
     consoleinput[0] = '\0';
@@ -209,10 +338,15 @@ void C_IntegerCVAROutput(const char *cvar, const int value)
 {
     char    *temp = commify(value);
 
-    if (!numconsolestrings || !M_StringStartsWithExact(console[numconsolestrings - 1].string, cvar))
+    if (!M_StringStartsWithExact(C_ConsoleLine(numconsolestrings - 1)->string, cvar))
         C_Input("%s %s", cvar, temp);
     else
-        M_snprintf(console[numconsolestrings - 1].string, sizeof(console[0].string), "%s %s", cvar, temp);
+    {
+        char    buffer[CONSOLETEXTMAXLENGTH];
+
+        M_snprintf(buffer, sizeof(buffer), "%s %s", cvar, temp);
+        C_ReplaceLastConsoleString(buffer);
+    }
 
     free(temp);
 }
@@ -221,20 +355,30 @@ void C_PercentCVAROutput(const char *cvar, const int value)
 {
     char    *temp = commify(value);
 
-    if (!numconsolestrings || !M_StringStartsWithExact(console[numconsolestrings - 1].string, cvar))
+    if (!M_StringStartsWithExact(C_ConsoleLine(numconsolestrings - 1)->string, cvar))
         C_Input("%s %s%%", cvar, temp);
     else
-        M_snprintf(console[numconsolestrings - 1].string, sizeof(console[0].string), "%s %s%%", cvar, temp);
+    {
+        char    buffer[CONSOLETEXTMAXLENGTH];
+
+        M_snprintf(buffer, sizeof(buffer), "%s %s%%", cvar, temp);
+        C_ReplaceLastConsoleString(buffer);
+    }
 
     free(temp);
 }
 
 void C_StringCVAROutput(const char *cvar, const char *string)
 {
-    if (!numconsolestrings || !M_StringStartsWithExact(console[numconsolestrings - 1].string, cvar))
+    if (!M_StringStartsWithExact(C_ConsoleLine(numconsolestrings - 1)->string, cvar))
         C_Input("%s %s", cvar, string);
     else
-        M_snprintf(console[numconsolestrings - 1].string, sizeof(console[0].string), "%s %s", cvar, string);
+    {
+        char    buffer[CONSOLETEXTMAXLENGTH];
+
+        M_snprintf(buffer, sizeof(buffer), "%s %s", cvar, string);
+        C_ReplaceLastConsoleString(buffer);
+    }
 }
 
 void C_Output(const char *string, ...)
@@ -249,14 +393,8 @@ void C_Output(const char *string, ...)
     M_vsnprintf(buffer, CONSOLETEXTMAXLENGTH - 1, string, args);
     va_end(args);
 
-    if (numconsolestrings >= (int)consolestringsmax)
-        console = I_Realloc(console, (consolestringsmax += CONSOLESTRINGSMAX) * sizeof(*console));
-
-    M_StringCopy(console[numconsolestrings].string, buffer, sizeof(console[0].string));
-    console[numconsolestrings].string[0] = toupper(console[numconsolestrings].string[0]);
-    console[numconsolestrings].indent = 0;
-    console[numconsolestrings].wrap = 0;
-    console[numconsolestrings++].stringtype = outputstring;
+    buffer[0] = toupper(buffer[0]);
+    C_AddConsoleString(buffer, outputstring);
     outputhistory = -1;
 }
 
@@ -269,50 +407,36 @@ bool C_OutputNoRepeat(const char *string, ...)
     M_vsnprintf(buffer, CONSOLETEXTMAXLENGTH - 1, string, args);
     va_end(args);
 
-    if (numconsolestrings && M_StringCompare(console[numconsolestrings - 1].string, buffer))
+    if (M_StringCompare(C_ConsoleLine(numconsolestrings - 1)->string, buffer))
         return true;
 
-    if (numconsolestrings >= (int)consolestringsmax)
-        console = I_Realloc(console, (consolestringsmax += CONSOLESTRINGSMAX) * sizeof(*console));
-
-    M_StringCopy(console[numconsolestrings].string, buffer, sizeof(console[0].string));
-    console[numconsolestrings].indent = 0;
-    console[numconsolestrings].wrap = 0;
-    console[numconsolestrings++].stringtype = outputstring;
+    C_AddConsoleString(buffer, outputstring);
     outputhistory = -1;
     return false;
 }
 
 void C_TabbedOutput(const int tabs[3], const char *string, ...)
 {
-    va_list args;
-    char    buffer[CONSOLETEXTMAXLENGTH];
+    va_list     args;
+    char        buffer[CONSOLETEXTMAXLENGTH];
+    console_t   *line;
 
     va_start(args, string);
     M_vsnprintf(buffer, CONSOLETEXTMAXLENGTH - 1, string, args);
     va_end(args);
 
-    if (numconsolestrings >= (int)consolestringsmax)
-        console = I_Realloc(console, (consolestringsmax += CONSOLESTRINGSMAX) * sizeof(*console));
-
-    M_StringCopy(console[numconsolestrings].string, buffer, sizeof(console[0].string));
-    console[numconsolestrings].stringtype = outputstring;
-    memcpy(console[numconsolestrings].tabs, tabs, sizeof(console[0].tabs));
-    console[numconsolestrings].indent = (tabs[2] ? tabs[2] : (tabs[1] ? tabs[1] : tabs[0])) - 10;
-    console[numconsolestrings++].wrap = 0;
+    line = C_AddConsoleString(buffer, outputstring);
+    memcpy(line->tabs, tabs, sizeof(line->tabs));
+    line->indent = (tabs[2] ? tabs[2] : (tabs[1] ? tabs[1] : tabs[0])) - 10;
     outputhistory = -1;
 }
 
 void C_Header(const int tabs[3], patch_t *header, const char *string)
 {
-    if (numconsolestrings >= (int)consolestringsmax)
-        console = I_Realloc(console, (consolestringsmax += CONSOLESTRINGSMAX) * sizeof(*console));
-
-    console[numconsolestrings].stringtype = headerstring;
-    memcpy(console[numconsolestrings].tabs, tabs, sizeof(console[0].tabs));
-    console[numconsolestrings].header = header;
-    console[numconsolestrings].wrap = 0;
-    M_StringCopy(console[numconsolestrings++].string, string, sizeof(console[0].string));
+    console_t   *line = C_AddConsoleString(string, headerstring);
+
+    memcpy(line->tabs, tabs, sizeof(line->tabs));
+    line->header = header;
     outputhistory = -1;
 }
 
@@ -328,15 +452,9 @@ void C_Warning(const int minwarninglevel, const char *string, ...)
     M_vsnprintf(buffer, CONSOLETEXTMAXLENGTH - 1, string, args);
     va_end(args);
 
-    if (!numconsolestrings || !M_StringCompare(console[numconsolestrings - 1].string, buffer))
+    if (!M_StringCompare(C_ConsoleLine(numconsolestrings - 1)->string, buffer))
     {
-        if (numconsolestrings >= (int)consolestringsmax)
-            console = I_Realloc(console, (consolestringsmax += CONSOLESTRINGSMAX) * sizeof(*console));
-
-        M_StringCopy(console[numconsolestrings].string, buffer, sizeof(console[0].string));
-        console[numconsolestrings].indent = WARNINGWIDTH + 2;
-        console[numconsolestrings].wrap = 0;
-        console[numconsolestrings++].stringtype = warningstring;
+        C_AddConsoleString(buffer, warningstring)->indent = WARNINGWIDTH + 2;
         outputhistory = -1;
     }
 }
@@ -345,31 +463,24 @@ void C_PlayerMessage(const char *string, ...)
 {
     va_list     args;
     char        buffer[CONSOLETEXTMAXLENGTH];
-    const int   i = numconsolestrings - 1;
+    console_t   *line = C_ConsoleLine(numconsolestrings - 1);
 
     va_start(args, string);
     M_vsnprintf(buffer, CONSOLETEXTMAXLENGTH - 1, string, args);
     va_end(args);
 
-    if (console[i].stringtype == playermessagestring && M_StringCompare(console[i].string, buffer) && groupmessages)
+    if (line->stringtype == playermessagestring && M_StringCompare(line->string, buffer) && groupmessages)
     {
-        console[i].tics = gametime;
-        console[i].timestamp[0] = '\0';
-        console[i].count++;
+        line->tics = gametime;
+        line->timestamp[0] = '\0';
+        line->count++;
     }
     else
     {
-        if (numconsolestrings >= (int)consolestringsmax)
-            console = I_Realloc(console, (consolestringsmax += CONSOLESTRINGSMAX) * sizeof(*console));
-
         M_StringReplaceAll(buffer, "\n", " ", false);
-        M_StringCopy(console[numconsolestrings].string, buffer, sizeof(console[0].string));
-        console[numconsolestrings].stringtype = playermessagestring;
-        console[numconsolestrings].tics = gametime;
-        console[numconsolestrings].timestamp[0] = '\0';
-        console[numconsolestrings].indent = 0;
-        console[numconsolestrings].wrap = 0;
-        console[numconsolestrings++].count = 1;
+        line = C_AddConsoleString(buffer, playermessagestring);
+        line->tics = gametime;
+        line->count = 1;
     }
 
     outputhistory = -1;
@@ -377,8 +488,8 @@ void C_PlayerMessage(const char *string, ...)
 
 void C_ResetWrappedLines(void)
 {
-    for (int i = 0; i < numconsolestrings; i++)
-        console[i].wrap = 0;
+    for (int i = CONSOLEBLANKLINES; i < numconsolestrings; i++)
+        C_ConsoleLine(i)->wrap = 0;
 }
 
 static void C_AddToUndoHistory(void)
@@ -393,14 +504,8 @@ static void C_AddToUndoHistory(void)
 
 void C_AddConsoleDivider(void)
 {
-    if (console[numconsolestrings - 1].stringtype != dividerstring || !numconsolestrings)
-    {
-        if (numconsolestrings >= (int)consolestringsmax)
-            console = I_Realloc(console, (consolestringsmax += CONSOLESTRINGSMAX) * sizeof(*console));
-
-        M_StringCopy(console[numconsolestrings].string, DIVIDERSTRING, sizeof(console[0].string));
-        console[numconsolestrings++].stringtype = dividerstring;
-    }
+    if (C_ConsoleLine(numconsolestrings - 1)->stringtype != dividerstring)
+        C_AddConsoleString(DIVIDERSTRING, dividerstring);
 }
 
 const kern_t altkern[] =
@@ -628,17 +733,15 @@ static void C_DrawScrollbar(void)
 
 void C_ClearConsole(void)
 {
-    numconsolestrings = 0;
-    consolestringsmax = CONSOLESTRINGSMAX;
-    console = I_Realloc(console, consolestringsmax * sizeof(*console));
+    static char blankstring[1];
 
-    for (int i = 0; i < CONSOLEBLANKLINES; i++)
-    {
-        console[numconsolestrings].string[0] = '\0';
-        console[numconsolestrings].indent = 0;
-        console[numconsolestrings].wrap = 0;
-        console[numconsolestrings++].stringtype = outputstring;
-    }
+    consoleblankline.string = blankstring;
+    consoleblankline.stringtype = outputstring;
+    numconsolestrings = CONSOLEBLANKLINES;
+    consolestart = 0;
+    consolepooltail = 0;
+    inputhistory = -1;
+    outputhistory = -1;
 }
 
 void C_Init(void)
@@ -724,6 +827,7 @@ void C_Init(void)
     timewidth = C_OverlayWidth("00:00", true);
 
     M_TranslateAutocomplete();
+    C_BuildAutocompleteIndex();
 }
 
 void C_ShowConsole(void)
@@ -911,9 +1015,9 @@ static int C_DrawConsoleText(int x, int y, char *text, const int color1, const i
 
     y -= CONSOLEHEIGHT - consoleheight;
 
-    if (console[index].stringtype == warningstring)
+    if (C_ConsoleLine(index)->stringtype == warningstring)
     {
-        V_DrawConsoleTextPatch(x - 1, y, warning, WARNINGWIDTH, color1, color2, false, tinttab);
+        consoletextfunc(x - 1, y, warning, WARNINGWIDTH, color1, color2, false, tinttab);
         x += (text[0] == 'T' ? WARNINGWIDTH : WARNINGWIDTH + 1);
     }
 
@@ -1083,6 +1187,177 @@ static int C_DrawConsoleText(int x, int y, char *text, const int color1, const i
     return (x - startx);
 }
 
+//
+// Console text cache
+//
+// Lines of console output are rendered once into a list of the pixels that
+// their characters would draw, grouped by row, and then blended straight onto
+// the console's background each frame without parsing them again. Lines are
+// keyed on their text, colors, position and tabs, and the width of the
+// console they were wrapped to.
+//
+#define CONSOLETEXTCACHESIZE    128
+#define CONSOLETEXTCACHEPROBES  8
+
+typedef struct
+{
+    short           x;
+    byte            row;
+    byte            color;
+} consoletextop_t;
+
+typedef struct
+{
+    char            *text;
+    unsigned int    hash;
+    int             x;
+    int             color1;
+    int             boldcolor;
+    const byte      *tinttab;
+    int             tabs[3];
+    int             maxwidth;
+    bool            warning;
+
+    int             numops;
+    consoletextop_t *ops;
+    uint64_t        lastused;
+} consoletextcache_t;
+
+static consoletextcache_t   consoletextcache[CONSOLETEXTCACHESIZE];
+static uint64_t             consoletextcachetime;
+
+static consoletextop_t      *recordedops;
+static int                  numrecordedops;
+static int                  maxrecordedops;
+
+static void C_RecordConsoleTextPatch(int x, int y, patch_t *patch, int width,
+    int color, int backgroundcolor, bool italics, const byte *tinttab)
+{
+    const int   italicize[] = { 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0, -1, -1, -1 };
+
+    for (int col = 0; col < width - 1; col++)
+    {
+        byte    *source = (byte *)patch + LONG(patch->columnoffset[col]) + 3;
+
+        for (int i = 0; i < CONSOLELINEHEIGHT; i++)
+            if (*source++)
+            {
+                if (numrecordedops >= maxrecordedops)
+                    recordedops = I_Realloc(recordedops, (maxrecordedops += 1024) * sizeof(*recordedops));
+
+                recordedops[numrecordedops].x = x + col + (italics ? italicize[i] : 0);
+                recordedops[numrecordedops].row = i;
+                recordedops[numrecordedops++].color = color;
+            }
+    }
+}
+
+static unsigned int C_ConsoleTextHash(const char *text, const int x, const int color1,
+    const int boldcolor, const int tabs[3], const int maxwidth, const bool warning)
+{
+    unsigned int    hash = 2166136261u;
+
+    while (*text)
+        hash = (hash ^ (unsigned char)*text++) * 16777619u;
+
+    hash = (hash ^ x) * 16777619u;
+    hash = (hash ^ color1) * 16777619u;
+    hash = (hash ^ boldcolor) * 16777619u;
+    hash = (hash ^ tabs[0] ^ (tabs[1] << 10) ^ (tabs[2] << 20)) * 16777619u;
+    hash = (hash ^ maxwidth) * 16777619u;
+
+    return (hash ^ warning);
+}
+
+static void C_DrawCachedConsoleText(const int x, const int y, char *text, const int color1,
+    const int boldcolor, const byte *tinttab, const int tabs[3], const int index)
+{
+    const int           maxwidth = CONSOLETEXTPIXELWIDTH;
+    const bool          warning = (C_ConsoleLine(index)->stringtype == warningstring);
+    const unsigned int  hash = C_ConsoleTextHash(text, x, color1, boldcolor, tabs, maxwidth, warning);
+    consoletextcache_t  *entry = NULL;
+    bool                cached = false;
+    const int           yy = y - (CONSOLEHEIGHT - consoleheight);
+
+    for (int i = 0; i < CONSOLETEXTCACHEPROBES; i++)
+    {
+        consoletextcache_t  *probe = &consoletextcache[(hash + i) % CONSOLETEXTCACHESIZE];
+
+        if (probe->text && probe->hash == hash && probe->x == x && probe->color1 == color1
+            && probe->boldcolor == boldcolor && probe->tinttab == tinttab
+            && !memcmp(probe->tabs, tabs, sizeof(probe->tabs)) && probe->maxwidth == maxwidth
+            && probe->warning == warning && !strcmp(probe->text, text))
+        {
+            entry = probe;
+            cached = true;
+            break;
+        }
+
+        // otherwise replace whichever of these entries was used least recently
+        if (!entry || probe->lastused < entry->lastused)
+            entry = probe;
+    }
+
+    if (!cached)
+    {
+        int counts[CONSOLELINEHEIGHT] = { 0 };
+        int starts[CONSOLELINEHEIGHT];
+
+        // render the text into the list of pixels it would draw
+        numrecordedops = 0;
+        consoletextfunc = &C_RecordConsoleTextPatch;
+        C_DrawConsoleText(x, y, text, color1, NOBACKGROUNDCOLOR, boldcolor, tinttab, tabs,
+            true, true, index, '\0', '\0');
+        consoletextfunc = &V_DrawConsoleTextPatch;
+
+        free(entry->text);
+        entry->text = M_StringDuplicate(text);
+        entry->hash = hash;
+        entry->x = x;
+        entry->color1 = color1;
+        entry->boldcolor = boldcolor;
+        entry->tinttab = tinttab;
+        memcpy(entry->tabs, tabs, sizeof(entry->tabs));
+        entry->maxwidth = maxwidth;
+        entry->warning = warning;
+        entry->numops = numrecordedops;
+        entry->ops = I_Realloc(entry->ops, MAX(1, numrecordedops) * sizeof(*entry->ops));
+
+        // group the pixels by row, keeping the order that they're drawn in
+        for (int i = 0; i < numrecordedops; i++)
+            counts[recordedops[i].row]++;
+
+        for (int i = 0, start = 0; i < CONSOLELINEHEIGHT; i++)
+        {
+            starts[i] = start;
+            start += counts[i];
+        }
+
+        for (int i = 0; i < numrecordedops; i++)
+            entry->ops[starts[recordedops[i].row]++] = recordedops[i];
+    }
+
+    entry->lastused = ++consoletextcachetime;
+
+    for (int i = 0; i < entry->numops; i++)
+    {
+        const consoletextop_t   *op = &entry->ops[i];
+        const int               row = yy + op->row;
+
+        if (row >= 0)
+        {
+            byte    *dot = &screens[0][row * SCREENWIDTH + op->x];
+
+            *dot = (!tinttab ? op->color : tinttab[(op->color << 8) + *dot]);
+
+            if (!row)
+                *dot = tinttab50[*dot];
+            else if (row == 1)
+                *dot = tinttab25[*dot];
+        }
+    }
+}
+
 static void C_DrawOverlayText(byte *screen, const int screenwidth, int x, const int y,
     const byte *tinttab, const char *text, const int color, const bool monospaced)
 {
@@ -1119,7 +1394,8 @@ char *C_CreateTimeStamp(const int index)
     int         hours = gamestarttime.tm_hour;
     int         minutes = gamestarttime.tm_min;
     int         seconds = gamestarttime.tm_sec;
-    const int   tics = console[index].tics / TICRATE;
+    console_t   *line = C_ConsoleLine(index);
+    const int   tics = line->tics / TICRATE;
 
     if ((seconds += (tics % 3600) % 60) >= 60)
     {
@@ -1136,9 +1412,9 @@ char *C_CreateTimeStamp(const int index)
     if ((hours += tics / 3600) > 12)
         hours %= 12;
 
-    M_snprintf(console[index].timestamp, sizeof(console[0].timestamp), "%i:%02i:%02i",
+    M_snprintf(line->timestamp, sizeof(line->timestamp), "%i:%02i:%02i",
         (!hours ? 12 : hours), minutes, seconds);
-    return console[index].timestamp;
+    return line->timestamp;
 }
 
 static void C_DrawTimeStamp(int x, const int y, const char timestamp[9])
@@ -1157,17 +1433,36 @@ static void C_DrawTimeStamp(int x, const int y, const char timestamp[9])
 
 void C_UpdateFPSOverlay(void)
 {
-    char    buffer[32];
+    char    buffer[64];
     char    *temp = commify(framespersecond);
     byte    *tinttab = (r_hud_translucency ? (automapactive ? tinttab70 : tinttab50) : NULL);
 
-    M_snprintf(buffer, sizeof(buffer), "%s FPS", temp);
+    if (devparm && gamestate == GS_LEVEL)
+        M_snprintf(buffer, sizeof(buffer), "%s FPS (%i/%i sight checks cached)",
+            temp, sightcachehits, sightcachehits + sightcachemisses);
+    else
+        M_snprintf(buffer, sizeof(buffer), "%s FPS", temp);
 
     C_DrawOverlayText(screens[0], SCREENWIDTH, SCREENWIDTH - C_OverlayWidth(buffer, true) - OVERLAYTEXTX + 1,
         OVERLAYTEXTY, tinttab, buffer, (framespersecond < (refreshrate && vid_capfps != TICRATE ? refreshrate :
         TICRATE) ? consoleoverlaywarningcolor : (((viewplayer->fixedcolormap == INVERSECOLORMAP) != !r_textures)
         && !automapactive ? nearestblack : (r_hud_translucency ? consoleoverlaycolor : nearestlightgray))), true);
     free(temp);
+
+    if (devparm && gamestate == GS_LEVEL)
+    {
+        char    thinkers[128];
+
+        M_snprintf(thinkers, sizeof(thinkers), "%i mobjs, %i movers, %i lights, %i scrollers, %i pushers",
+            thinkercount[th_mobj],
+            thinkercount[th_mover],
+            thinkercount[th_flash] + thinkercount[th_strobe] + thinkercount[th_glow] + thinkercount[th_fireflicker],
+            thinkercount[th_scroll], thinkercount[th_pusher]);
+        C_DrawOverlayText(screens[0], SCREENWIDTH, SCREENWIDTH - C_OverlayWidth(thinkers, true) - OVERLAYTEXTX + 1,
+            OVERLAYTEXTY + OVERLAYLINEHEIGHT + OVERLAYSPACING, tinttab, thinkers,
+            (((viewplayer->fixedcolormap == INVERSECOLORMAP) != !r_textures) && !automapactive ? nearestblack :
+            (r_hud_translucency ? consoleoverlaycolor : nearestlightgray)), true);
+    }
 }
 
 void C_UpdateTimerOverlay(void)
@@ -1178,7 +1473,7 @@ void C_UpdateTimerOverlay(void)
     int         y = OVERLAYTEXTY;
 
     if (vid_showfps && framespersecond)
-        y += OVERLAYLINEHEIGHT + OVERLAYSPACING;
+        y += (OVERLAYLINEHEIGHT + OVERLAYSPACING) * (devparm ? 2 : 1);
 
     if (timeremaining != prevtime)
     {
@@ -1210,7 +1505,7 @@ void C_UpdatePlayerPositionOverlay(void)
     static char coordinates[32];
 
     if (vid_showfps && framespersecond)
-        y += OVERLAYLINEHEIGHT + OVERLAYSPACING;
+        y += (OVERLAYLINEHEIGHT + OVERLAYSPACING) * (devparm ? 2 : 1);
 
     if (timer)
         y += OVERLAYLINEHEIGHT + OVERLAYSPACING;
@@ -1482,7 +1777,8 @@ void C_Drawer(void)
     // draw console text
     for (i = bottomline; i >= 0; i--)
     {
-        const stringtype_t  stringtype = console[i].stringtype;
+        console_t           *line = C_ConsoleLine(i);
+        const stringtype_t  stringtype = line->stringtype;
 
         if (stringtype == dividerstring)
         {
@@ -1508,20 +1804,20 @@ void C_Drawer(void)
                 }
             }
         }
-        else if (!(topofconsole = !((len = (int)strlen(console[i].string)))))
+        else if (!(topofconsole = !((len = (int)strlen(line->string)))))
         {
             int     wrap = len;
             char    *text;
 
-            if (console[i].wrap)
-                wrap = console[i].wrap;
+            if (line->wrap)
+                wrap = line->wrap;
             else
             {
-                const int   indent = console[i].indent;
+                const int   indent = line->indent;
 
                 do
                 {
-                    char    *temp = M_SubString(console[i].string, 0, wrap);
+                    char    *temp = M_SubString(line->string, 0, wrap);
                     int     width;
 
                     if (stringtype == warningstring)
@@ -1532,31 +1828,31 @@ void C_Drawer(void)
 
                     free(temp);
 
-                    if (width <= CONSOLETEXTPIXELWIDTH && isbreak(console[i].string[wrap]))
+                    if (width <= CONSOLETEXTPIXELWIDTH && isbreak(line->string[wrap]))
                     {
-                        if (console[i].string[wrap] == '-')
+                        if (line->string[wrap] == '-')
                             wrap++;
 
                         break;
                     }
                 } while (wrap-- > 0);
 
-                console[i].wrap = wrap;
+                line->wrap = wrap;
             }
 
             if (wrap < len)
             {
-                text = M_SubString(console[i].string, 0, wrap);
+                text = M_SubString(line->string, 0, wrap);
 
                 if (i < bottomline)
                     y -= CONSOLELINEHEIGHT;
             }
             else
-                text = M_StringDuplicate(console[i].string);
+                text = M_StringDuplicate(line->string);
 
             if (stringtype == playermessagestring)
             {
-                const int   count = console[i].count;
+                const int   count = line->count;
 
                 if (count > 1)
                 {
@@ -1564,36 +1860,36 @@ void C_Drawer(void)
                     char    *temp = commify(count);
 
                     M_snprintf(buffer, sizeof(buffer), "%s (%s)", text, temp);
-                    C_DrawConsoleText(CONSOLETEXTX, y, buffer, consoleplayermessagecolor, NOBACKGROUNDCOLOR,
-                        consoleplayermessagecolor, tinttab66, notabs, true, true, i, '\0', '\0');
+                    C_DrawCachedConsoleText(CONSOLETEXTX, y, buffer, consoleplayermessagecolor,
+                        consoleplayermessagecolor, tinttab66, notabs, i);
                     free(temp);
                 }
                 else
-                    C_DrawConsoleText(CONSOLETEXTX, y, text, consoleplayermessagecolor, NOBACKGROUNDCOLOR,
-                        consoleplayermessagecolor, tinttab66, notabs, true, true, i, '\0', '\0');
+                    C_DrawCachedConsoleText(CONSOLETEXTX, y, text, consoleplayermessagecolor,
+                        consoleplayermessagecolor, tinttab66, notabs, i);
 
-                if (!*console[i].timestamp)
+                if (!*line->timestamp)
                     C_CreateTimeStamp(i);
 
                 C_DrawTimeStamp(SCREENWIDTH - CONSOLETEXTX - 10 - CONSOLESCROLLBARWIDTH + 1,
-                    y - (CONSOLEHEIGHT - consoleheight), console[i].timestamp);
+                    y - (CONSOLEHEIGHT - consoleheight), line->timestamp);
             }
             else if (stringtype == outputstring)
-                C_DrawConsoleText(CONSOLETEXTX, y, text, consoleoutputcolor, NOBACKGROUNDCOLOR,
-                    consoleboldcolor, tinttab66, console[i].tabs, true, true, i, '\0', '\0');
+                C_DrawCachedConsoleText(CONSOLETEXTX, y, text, consoleoutputcolor,
+                    consoleboldcolor, tinttab66, line->tabs, i);
             else if (stringtype == inputstring || stringtype == cheatstring)
-                C_DrawConsoleText(CONSOLETEXTX, y, text, consoleinputcolor, NOBACKGROUNDCOLOR,
-                    consoleboldcolor, tinttab75, notabs, true, true, i, '\0', '\0');
+                C_DrawCachedConsoleText(CONSOLETEXTX, y, text, consoleinputcolor,
+                    consoleboldcolor, tinttab75, notabs, i);
             else if (stringtype == warningstring)
-                C_DrawConsoleText(CONSOLETEXTX, y, text, consolewarningcolor, NOBACKGROUNDCOLOR,
-                    consolewarningboldcolor, tinttab66, notabs, true, true, i, '\0', '\0');
+                C_DrawCachedConsoleText(CONSOLETEXTX, y, text, consolewarningcolor,
+                    consolewarningboldcolor, tinttab66, notabs, i);
             else
                 V_DrawConsolePatch(CONSOLETEXTX - 1, y + 4 - (CONSOLEHEIGHT - consoleheight),
-                    console[i].header, CONSOLETEXTPIXELWIDTH + 2);
+                    line->header, CONSOLETEXTPIXELWIDTH + 2);
 
             if (wrap < len && i < bottomline)
             {
-                char    *temp = M_SubString(console[i].string, wrap, (size_t)len - wrap);
+                char    *temp = M_SubString(line->string, wrap, (size_t)len - wrap);
                 bool    bold = false;
                 bool    italics = false;
 
@@ -1621,9 +1917,9 @@ void C_Drawer(void)
                 if (italics)
                     temp = M_StringJoin(ITALICSON, temp, NULL);
 
-                C_DrawConsoleText(CONSOLETEXTX + console[i].indent, y + CONSOLELINEHEIGHT,
-                    trimwhitespace(temp), consolecolors[stringtype], NOBACKGROUNDCOLOR,
-                    consoleboldcolors[stringtype], tinttab66, notabs, true, true, 0, '\0', '\0');
+                C_DrawCachedConsoleText(CONSOLETEXTX + line->indent, y + CONSOLELINEHEIGHT,
+                    trimwhitespace(temp), consolecolors[stringtype], consoleboldcolors[stringtype],
+                    tinttab66, notabs, 0);
                 free(temp);
             }
 
@@ -1632,7 +1928,7 @@ void C_Drawer(void)
 
         if ((y -= CONSOLELINEHEIGHT) < -CONSOLELINEHEIGHT)
         {
-            while (!strlen(console[++i].string))
+            while (!strlen(C_ConsoleLine(++i)->string))
                 outputhistory++;
 
             break;
@@ -1806,13 +2102,56 @@ bool C_ExecuteInputString(const char *input)
     return true;
 }
 
+//
+// Find every entry in consolecmds[] that input could refer to, in the order
+// they appear: a cheat named input, a cheat named input less its last two
+// digits, or a CCMD or CVAR named input's first word.
+//
+static int C_FindInputCmds(const char *input, const int length, int *indices)
+{
+    char    name[128] = "";
+    int     count = C_FindConsoleCmds(input, indices, CONSOLECMDMATCHESMAX);
+
+    if (length >= 2 && length - 2 < (int)sizeof(name))
+    {
+        M_StringCopy(name, input, (size_t)length - 1);
+        count += C_FindConsoleCmds(name, &indices[count], CONSOLECMDMATCHESMAX * 3 - count);
+    }
+
+    if (sscanf(input, "%127s", name) == 1)
+        count += C_FindConsoleCmds(name, &indices[count], CONSOLECMDMATCHESMAX * 3 - count);
+
+    // sort and remove duplicates
+    for (int i = 1; i < count; i++)
+    {
+        const int   index = indices[i];
+        int         j = i;
+
+        for (; j > 0 && indices[j - 1] > index; j--)
+            indices[j] = indices[j - 1];
+
+        indices[j] = index;
+    }
+
+    for (int i = 1, j = 0; i <= count; i++)
+        if (i == count)
+            count = j + 1;
+        else if (indices[i] != indices[j])
+            indices[++j] = indices[i];
+
+    return count;
+}
+
 bool C_ValidateInput(char *input)
 {
     const int   length = (int)strlen(input);
+    int         indices[CONSOLECMDMATCHESMAX * 3];
+    const int   count = C_FindInputCmds(input, length, indices);
 
-    for (int i = 0; *consolecmds[i].name; i++)
+    for (int k = 0; k < count; k++)
     {
-        char    cmd[128] = "";
+        const int   i = indices[k];
+        char        cmd[128] = "";
 
         if (consolecmds[i].type == CT_CHEAT)
         {
@@ -1903,6 +2242,89 @@ bool C_ValidateInput(char *input)
     return false;
 }
 
+//
+// Autocomplete index
+//
+// autocompletelist[] is sorted case-insensitively into autocompleteindex[]
+// once, so that every entry starting with the input is found by binary
+// search as one contiguous range. Those entries are then put back in the
+// order they appear in autocompletelist[], which is the order TAB and
+// SHIFT+TAB cycle through them.
+//
+static int  *autocompleteindex;
+static int  numautocomplete;
+
+static int  *autocompletematches;
+static int  numautocompletematches;
+
+static int C_CompareAutocomplete(const void *a, const void *b)
+{
+    const int   i = *(const int *)a;
+    const int   j = *(const int *)b;
+    const int   result = strcasecmp(autocompletelist[i].text, autocompletelist[j].text);
+
+    return (result ? result : i - j);
+}
+
+static int C_CompareAutocompleteMatches(const void *a, const void *b)
+{
+    return (*(const int *)a - *(const int *)b);
+}
+
+void C_BuildAutocompleteIndex(void)
+{
+    numautocomplete = 0;
+
+    while (*autocompletelist[numautocomplete].text)
+        numautocomplete++;
+
+    autocompleteindex = I_Realloc(autocompleteindex, numautocomplete * sizeof(*autocompleteindex));
+    autocompletematches = I_Realloc(autocompletematches, numautocomplete * sizeof(*autocompletematches));
+
+    for (int i = 0; i < numautocomplete; i++)
+        autocompleteindex[i] = i;
+
+    qsort(autocompleteindex, numautocomplete, sizeof(*autocompleteindex), &C_CompareAutocomplete);
+}
+
+static int C_AutocompleteBound(const char *input, const size_t len, const bool upper)
+{
+    int low = 0;
+    int high = numautocomplete;
+
+    while (low < high)
+    {
+        const int   mid = (low + high) / 2;
+        const int   result = strncasecmp(autocompletelist[autocompleteindex[mid]].text, input, len);
+
+        if (result < 0 || (upper && !result))
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+static void C_FindAutocompleteMatches(const char *input)
+{
+    const size_t    len = strlen(input);
+    const int       high = C_AutocompleteBound(input, len, true);
+
+    numautocompletematches = 0;
+
+    for (int i = C_AutocompleteBound(input, len, false); i < high; i++)
+    {
+        const int   index = autocompleteindex[i];
+        const int   game = autocompletelist[index].game;
+
+        if (game == DOOM1AND2 || (gamemission == doom && game == DOOM1ONLY) || (gamemission != doom && game == DOOM2ONLY))
+            autocompletematches[numautocompletematches++] = index;
+    }
+
+    qsort(autocompletematches, numautocompletematches, sizeof(*autocompletematches), &C_CompareAutocompleteMatches);
+}
+
 bool C_Responder(event_t *ev)
 {
     static int  autocomplete = -1;
@@ -2185,26 +2607,28 @@ bool C_Responder(event_t *ev)
                     spaces1 = numspaces(input);
                     endspace1 = (input[strlen(input) - 1] == ' ');
 
-                    while ((scrolldirection == -1 && autocomplete > 0)
-                        || (scrolldirection == 1 && (autocomplete == -1 || *autocompletelist[autocomplete].text)))
+                    if (autocomplete == -1)
+                        C_FindAutocompleteMatches(input);
+
+                    for (int j = (scrolldirection == 1 ? 0 : numautocompletematches - 1);
+                        j >= 0 && j < numautocompletematches; j += scrolldirection)
                     {
                         static char output[255];
+                        const int   index = autocompletematches[j];
+
+                        if (scrolldirection == 1 ? index <= autocomplete : (autocomplete == -1 || index >= autocomplete))
+                            continue;
 
-                        autocomplete += scrolldirection;
+                        autocomplete = index;
                         M_StringCopy(output, autocompletelist[autocomplete].text, sizeof(output));
 
                         if (!M_StringCompare(output, input))
                         {
-                            const int   game = autocompletelist[autocomplete].game;
                             const int   len2 = (int)strlen(output);
                             const int   spaces2 = numspaces(output);
                             const bool  endspace2 = (len2 > 0 && output[len2 - 1] == ' ');
 
-                            if ((game == DOOM1AND2
-                                || (gamemission == doom && game == DOOM1ONLY)
-                                || (gamemission != doom && game == DOOM2ONLY))
-                                && M_StringStartsWith(output, input)
-                                && input[strlen(input) - 1] != '+'
+                            if (input[strlen(input) - 1] != '+'
                                 && ((!spaces1 && (!spaces2 || (spaces2 == 1 && endspace2)))
                                     || (spaces1 == 1 && !endspace1 && (spaces2 == 1 || (spaces2 == 2 && endspace2)))
                                     || (spaces1 == 2 && !endspace1 && (spaces2 == 2 || (spaces2 == 3 && endspace2)))
@@ -2248,12 +2672,12 @@ bool C_Responder(event_t *ev)
                         M_StringCopy(currentinput, consoleinput, sizeof(currentinput));
 
                     for (i = (inputhistory == -1 ? numconsolestrings : inputhistory) - 1; i >= 0; i--)
-                        if (console[i].stringtype == inputstring
-                            && !M_StringCompare(consoleinput, console[i].string)
-                            && C_TextWidth(console[i].string, false, true) <= CONSOLEINPUTPIXELWIDTH)
+                        if (C_ConsoleLine(i)->stringtype == inputstring
+                            && !M_StringCompare(consoleinput, C_ConsoleLine(i)->string)
+                            && C_TextWidth(C_ConsoleLine(i)->string, false, true) <= CONSOLEINPUTPIXELWIDTH)
                         {
                             inputhistory = i;
-                            M_StringCopy(consoleinput, console[i].string, sizeof(consoleinput));
+                            M_StringCopy(consoleinput, C_ConsoleLine(i)->string, sizeof(consoleinput));
                             caretpos = selectstart = selectend = (int)strlen(consoleinput);
                             caretwait = I_GetTimeMS() + CARETBLINKTIME;
                             showcaret = true;
@@ -2279,12 +2703,12 @@ bool C_Responder(event_t *ev)
                     if (inputhistory != -1)
                     {
                         for (i = inputhistory + 1; i < numconsolestrings; i++)
-                            if (console[i].stringtype == inputstring
-                                && !M_StringCompare(consoleinput, console[i].string)
-                                && C_TextWidth(console[i].string, false, true) <= CONSOLEINPUTPIXELWIDTH)
+                            if (C_ConsoleLine(i)->stringtype == inputstring
+                                && !M_StringCompare(consoleinput, C_ConsoleLine(i)->string)
+                                && C_TextWidth(C_ConsoleLine(i)->string, false, true) <= CONSOLEINPUTPIXELWIDTH)
                             {
                                 inputhistory = i;
-                                M_StringCopy(consoleinput, console[i].string, sizeof(consoleinput));
+                                M_StringCopy(consoleinput, C_ConsoleLine(i)->string, sizeof(consoleinput));
                                 break;
                             }
 
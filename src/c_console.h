@@ -41,7 +41,7 @@
 #include "hu_lib.h"
 #include "r_defs.h"
 
-#define CONSOLESTRINGSMAX                   1024
+#define CONSOLEPOOLBYTESPERSTRING           128
 
 #define CONSOLEFONTSTART                    32
 #define CONSOLEFONTEND                      255
@@ -160,7 +160,7 @@ typedef enum
 
 typedef struct
 {
-    char            string[1024];
+    char            *string;
     int             count;
     stringtype_t    stringtype;
     int             wrap;
@@ -207,8 +207,6 @@ extern patch_t              *mapstats;
 extern patch_t              *playerstats;
 extern patch_t              *thinglist;
 
-extern console_t            *console;
-
 extern bool                 consoleactive;
 extern int                  consoleheight;
 extern int                  consoledirection;
@@ -234,6 +232,7 @@ extern const kern_t         altkern[];
 
 extern autocomplete_t       autocompletelist[];
 
+console_t *C_ConsoleLine(const int index);
 void C_Input(const char *string, ...);
 void C_Cheat(const char *string);
 void C_IntegerCVAROutput(const char *cvar, const int value);
@@ -248,6 +247,7 @@ void C_PlayerMessage(const char *string, ...);
 void C_ResetWrappedLines(void);
 void C_AddConsoleDivider(void);
 void C_ClearConsole(void);
+void C_BuildAutocompleteIndex(void);
 void C_Init(void);
 void C_ShowConsole(void);
 void C_HideConsole(void);
@@ -2363,7 +2363,7 @@ void D_ProcessDehFile(char *filename, int lumpnum, bool autoloaded)
     }
 
     if (infile.lump)
-        Z_ChangeTag(infile.lump, PU_CACHE);                     // mark purgeable
+        W_ReleaseLumpNum(lumpnum);                              // mark purgeable
     else
         fclose(infile.f);                                       // close real file
 
@@ -3385,6 +3385,7 @@ static void D_UpdateConsoleCheat(char *cheat1, char *cheat2)
         if (consolecmds[i].type == CT_CHEAT && M_StringCompare(consolecmds[i].name, cheat1))
         {
             consolecmds[i].name = M_StringDuplicate(cheat2);
+            C_BuildConsoleCmdIndex();
             break;
         }
 }
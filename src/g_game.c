@@ -1447,7 +1447,7 @@ static void G_DoCompleted(void)
     stat_mapscompleted = SafeAdd(stat_mapscompleted, 1);
     M_SaveCVARs();
 
-    if (!numconsolestrings || (!M_StringCompare(console[numconsolestrings - 1].string, "exitmap")))
+    if (!numconsolestrings || (!M_StringCompare(C_ConsoleLine(numconsolestrings - 1)->string, "exitmap")))
         C_Input("exitmap");
 
     WI_Start(&wminfo);
@@ -1533,7 +1533,7 @@ void G_DoLoadGame(void)
     loadaction = gameaction;
     gameaction = ga_nothing;
 
-    if (numconsolestrings == 1 || !M_StringStartsWith(console[numconsolestrings - 1].string, "load "))
+    if (numconsolestrings == 1 || !M_StringStartsWith(C_ConsoleLine(numconsolestrings - 1)->string, "load "))
         C_Input("load %s", savename);
 
     if (!(save_stream = fopen(savename, "rb")))
@@ -1682,7 +1682,7 @@ static void G_DoSaveGame(void)
         if (savegameslot >= 0)
             savegames = true;
 
-        if (!numconsolestrings || !M_StringStartsWith(console[numconsolestrings - 1].string, "save "))
+        if (!numconsolestrings || !M_StringStartsWith(C_ConsoleLine(numconsolestrings - 1)->string, "save "))
             C_Input("save %s", savegame_file);
 
         if (!*savedescription)
@@ -1858,9 +1858,9 @@ void G_InitNew(skill_t skill, int ep, int map)
     gameskill = skill;
 
     if (numconsolestrings == 1
-        || (!M_StringCompare(console[numconsolestrings - 2].string, "newgame")
-            && !M_StringStartsWith(console[numconsolestrings - 2].string, "map ")
-            && !M_StringStartsWith(console[numconsolestrings - 1].string, "load ")
+        || (!M_StringCompare(C_ConsoleLine(numconsolestrings - 2)->string, "newgame")
+            && !M_StringStartsWith(C_ConsoleLine(numconsolestrings - 2)->string, "map ")
+            && !M_StringStartsWith(C_ConsoleLine(numconsolestrings - 1)->string, "load ")
             && !autostart))
         C_Input("newgame");
 
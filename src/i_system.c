@@ -305,3 +305,128 @@ void *I_Realloc(void *block, size_t size)
     block = newp;
     return block;
 }
+
+//
+// I_CreateThread
+// Starts calling func(data) in another thread. If a thread can't be
+// created, func(data) is called before returning NULL instead.
+//
+void *I_CreateThread(int (*func)(void *), void *data)
+{
+    SDL_Thread  *thread = SDL_CreateThread((SDL_ThreadFunction)func, "", data);
+
+    if (!thread)
+        func(data);
+
+    return thread;
+}
+
+void I_WaitThread(void *thread)
+{
+    if (thread)
+        SDL_WaitThread(thread, NULL);
+}
+
+//
+// I_ParallelFor
+// Calls func(start, end, thread) for ranges that together cover 0 to
+// count - 1, one range per core, and returns once they have all finished.
+// Each range is given a different thread, from 0 to MAXTHREADS - 1. No range
+// is given fewer than mincount items, so counts too small to be worth
+// splitting are done in one range on this thread.
+//
+// The other threads are started the first time they are needed and then
+// wait on a semaphore between calls, so a call costs a few semaphore posts
+// rather than creating and joining a thread per range. A call made while
+// another is still running, such as from inside func, is done on the
+// calling thread instead.
+//
+typedef struct
+{
+    void    (*func)(int, int, int);
+    int     start;
+    int     end;
+    int     thread;
+    SDL_sem *wake;
+} threadrange_t;
+
+static threadrange_t    workerranges[MAXTHREADS];
+static int              numworkers = -1;
+static SDL_sem          *workersdone;
+static SDL_atomic_t     parallelforbusy;
+
+static int I_ParallelForWorker(void *data)
+{
+    threadrange_t   *range = data;
+
+    while (true)
+    {
+        SDL_SemWait(range->wake);
+        range->func(range->start, range->end, range->thread);
+        SDL_SemPost(workersdone);
+    }
+
+    return 0;
+}
+
+static void I_StartParallelForWorkers(void)
+{
+    const int   cores = BETWEEN(1, SDL_GetCPUCount(), MAXTHREADS);
+
+    numworkers = 0;
+
+    if (cores <= 1 || !(workersdone = SDL_CreateSemaphore(0)))
+        return;
+
+    for (int i = 1; i < cores; i++)
+    {
+        threadrange_t   *range = &workerranges[i];
+        SDL_Thread      *thread;
+
+        if (!(range->wake = SDL_CreateSemaphore(0)))
+            break;
+
+        if (!(thread = SDL_CreateThread(&I_ParallelForWorker, "I_ParallelFor", range)))
+        {
+            SDL_DestroySemaphore(range->wake);
+            range->wake = NULL;
+            break;
+        }
+
+        SDL_DetachThread(thread);
+        numworkers++;
+    }
+}
+
+void I_ParallelFor(void (*func)(int start, int end, int thread), int count, int mincount)
+{
+    int numthreads;
+
+    if (numworkers < 0)
+        I_StartParallelForWorkers();
+
+    if ((numthreads = MIN(numworkers + 1, count / MAX(1, mincount))) <= 1
+        || !SDL_AtomicCAS(&parallelforbusy, 0, 1))
+    {
+        func(0, count, 0);
+        return;
+    }
+
+    for (int i = 1; i < numthreads; i++)
+    {
+        threadrange_t   *range = &workerranges[i];
+
+        range->func = func;
+        range->start = (int)((int64_t)count * i / numthreads);
+        range->end = (int)((int64_t)count * (i + 1) / numthreads);
+        range->thread = i;
+        SDL_SemPost(range->wake);
+    }
+
+    func(0, (int)((int64_t)count / numthreads), 0);
+
+    for (int i = 1; i < numthreads; i++)
+        SDL_SemWait(workersdone);
+
+    SDL_AtomicSet(&parallelforbusy, 0);
+}
@@ -52,6 +52,8 @@
 #define DESKTOP "desktop"
 #endif
 
+#define MAXTHREADS  16
+
 #if defined(_WIN32)
 void I_ShutdownWindows32(void);
 #endif
@@ -65,3 +67,7 @@ void I_PrintWindowsVersion(void);
 void I_PrintSystemInfo(void);
 
 void *I_Realloc(void *block, size_t size);
+
+void *I_CreateThread(int (*func)(void *), void *data);
+void I_WaitThread(void *thread);
+void I_ParallelFor(void (*func)(int start, int end, int thread), int count, int mincount);
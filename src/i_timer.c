@@ -57,6 +57,24 @@ uint64_t I_GetTimeMS(void)
     return SDL_GetTicks64();
 }
 
+//
+// Same as I_GetTime(), but returns time in microseconds
+//
+uint64_t I_GetTimeUS(void)
+{
+    static uint64_t frequency;
+    uint64_t        counter;
+
+    if (!frequency)
+        frequency = SDL_GetPerformanceFrequency();
+
+    // split the conversion so that it can't overflow however long the
+    // system has been up
+    counter = SDL_GetPerformanceCounter();
+
+    return (counter / frequency * 1000000 + counter % frequency * 1000000 / frequency);
+}
+
 //
 // Sleep for a specified number of milliseconds
 //
@@ -42,5 +42,8 @@ uint64_t I_GetTime(void);
 // returns current time in ms
 uint64_t I_GetTimeMS(void);
 
+// returns current time in us
+uint64_t I_GetTimeUS(void);
+
 // Pause for a specified number of ms
 void I_Sleep(int ms);
@@ -86,10 +86,13 @@ bool        autoload = autoload_default;
 bool        autosave = autosave_default;
 bool        autotilt = autotilt_default;
 bool        autouse = autouse_default;
+int         cachesize = cachesize_default;
 bool        centerweapon = centerweapon_default;
+int         con_backscroll = con_backscroll_default;
 bool        con_obituaries = con_obituaries_default;
 int         crosshair = crosshair_default;
 int         crosshaircolor = crosshaircolor_default;
+bool        dormantmonsters = dormantmonsters_default;
 int         english = english_default;
 int         episode = episode_default;
 int         expansion = expansion_default;
@@ -324,10 +327,13 @@ static default_t cvars[] =
     CVAR_BOOL         (autosave,                         autosave,                              autosave,                            BOOLVALUEALIAS     ),
     CVAR_BOOL         (autotilt,                         autotilt,                              autotilt,                            BOOLVALUEALIAS     ),
     CVAR_BOOL         (autouse,                          autouse,                               autouse,                             BOOLVALUEALIAS     ),
+    CVAR_INT          (cachesize,                        cachesize,                             cachesize,                           NOVALUEALIAS       ),
     CVAR_BOOL         (centerweapon,                     centreweapon,                          centerweapon,                        BOOLVALUEALIAS     ),
+    CVAR_INT          (con_backscroll,                   con_backscroll,                        con_backscroll,                      NOVALUEALIAS       ),
     CVAR_BOOL         (con_obituaries,                   con_obituaries,                        con_obituaries,                      BOOLVALUEALIAS     ),
     CVAR_INT          (crosshair,                        crosshair,                             crosshair,                           CROSSHAIRVALUEALIAS),
     CVAR_INT          (crosshaircolor,                   crosshaircolour,                       crosshaircolor,                      NOVALUEALIAS       ),
+    CVAR_BOOL         (dormantmonsters,                  dormantmonsters,                       dormantmonsters,                     BOOLVALUEALIAS     ),
     CVAR_BOOL         (english,                          english,                               english,                             ENGLISHVALUEALIAS  ),
     CVAR_INT          (episode,                          episode,                               episode,                             NOVALUEALIAS       ),
     CVAR_INT          (expansion,                        expansion,                             expansion,                           NOVALUEALIAS       ),
@@ -910,6 +916,10 @@ static void M_CheckCVARs(void)
     if (!*iwadfolder || M_StringCompare(iwadfolder, iwadfolder_default) || !M_FolderExists(iwadfolder))
         D_InitIWADFolder();
 
+    cachesize = BETWEEN(cachesize_min, cachesize, cachesize_max);
+
+    con_backscroll = BETWEEN(con_backscroll_min, con_backscroll, con_backscroll_max);
+
     I_SetGameControllerLeftDeadZone();
     I_SetGameControllerRightDeadZone();
     I_SetGameControllerHorizontalSensitivity();
@@ -976,6 +986,43 @@ static void M_CheckCVARs(void)
     }
 }
 
+//
+// M_BuildCVARHash
+//
+// Each CVAR's name and old name are hashed into an open-addressed table, so
+// that loading a config file doesn't walk all of cvars[] for every line.
+// Each slot holds an index into cvars[] shifted left once, with the low bit
+// set for an old name, plus one so that zero marks an empty slot.
+//
+#define CVARHASHSIZE    1024
+
+static int  cvarhash[CVARHASHSIZE];
+static bool cvarhashbuilt;
+
+static void M_BuildCVARHash(void)
+{
+    const int   numcvars = arrlen(cvars);
+
+    for (int i = 0; i < numcvars; i++)
+        for (int key = 0; key < 2; key++)
+        {
+            const char  *name = (key ? cvars[i].oldname : cvars[i].name);
+            int         slot;
+
+            if (!*name || *name == ';' || (key && M_StringCompare(name, cvars[i].name)))
+                continue;
+
+            slot = M_StringHash(name) & (CVARHASHSIZE - 1);
+
+            while (cvarhash[slot])
+                slot = (slot + 1) & (CVARHASHSIZE - 1);
+
+            cvarhash[slot] = ((i << 1) | key) + 1;
+        }
+
+    cvarhashbuilt = true;
+}
+
 //
 // M_LoadCVARs
 //
@@ -985,11 +1032,13 @@ void M_LoadCVARs(char *filename)
     int         bindcount = 0;
     int         cvarcount = 0;
     int         statcount = 0;
-    const int   numcvars = arrlen(cvars);
 
     // read the file in, overriding any set defaults
     FILE        *file = fopen(filename, "rt");
 
+    if (!cvarhashbuilt)
+        M_BuildCVARHash();
+
     if (!file)
     {
         M_SaveCVARs();
@@ -1075,9 +1124,11 @@ void M_LoadCVARs(char *filename)
         }
 
         // Find the setting in the list
-        for (int i = 0; i < numcvars; i++)
+        for (int slot = M_StringHash(cvar) & (CVARHASHSIZE - 1); cvarhash[slot]; slot = (slot + 1) & (CVARHASHSIZE - 1))
         {
-            if (!M_StringCompare(cvar, cvars[i].name) && !M_StringCompare(cvar, cvars[i].oldname))
+            const int   i = (cvarhash[slot] - 1) >> 1;
+
+            if (!M_StringCompare(cvar, ((cvarhash[slot] - 1) & 1 ? cvars[i].oldname : cvars[i].name)))
                 continue;       // not this one
 
             // parameter found
@@ -77,10 +77,13 @@ extern bool     autoload;
 extern bool     autosave;
 extern bool     autotilt;
 extern bool     autouse;
+extern int      cachesize;
 extern bool     centerweapon;
+extern int      con_backscroll;
 extern bool     con_obituaries;
 extern int      crosshair;
 extern int      crosshaircolor;
+extern bool     dormantmonsters;
 extern int      english;
 extern int      episode;
 extern int      expansion;
@@ -448,8 +451,16 @@ enum
 
 #define autouse_default                    false
 
+#define cachesize_min                      8
+#define cachesize_default                  64
+#define cachesize_max                      1024
+
 #define centerweapon_default               true
 
+#define con_backscroll_min                 100
+#define con_backscroll_default             10000
+#define con_backscroll_max                 100000
+
 #define con_obituaries_default             true
 
 #define crosshair_min                      crosshair_none
@@ -460,6 +471,8 @@ enum
 #define crosshaircolor_default             4
 #define crosshaircolor_max                 255
 
+#define dormantmonsters_default            false
+
 #define english_default                    english_american
 
 #define episode_min                        1
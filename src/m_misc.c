@@ -590,6 +590,18 @@ bool M_StringCompare(const char *str1, const char *str2)
     return !strcasecmp(str1, str2);
 }
 
+// Returns a case-insensitive hash of a string, so that two strings that
+// M_StringCompare() considers equal always hash to the same value.
+unsigned int M_StringHash(const char *string)
+{
+    unsigned int    hash = 2166136261u;
+
+    while (*string)
+        hash = (hash ^ tolower((unsigned char)*string++)) * 16777619u;
+
+    return hash;
+}
+
 // Returns true if string begins with the specified prefix.
 bool M_StringStartsWith(const char *s, const char *prefix)
 {
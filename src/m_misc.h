@@ -88,6 +88,7 @@ void M_snprintf(char *buf, int buf_len, const char *s, ...);
 char *M_SubString(const char *str, size_t begin, size_t len);
 char *M_StringDuplicate(const char *orig);
 bool M_StringCompare(const char *str1, const char *str2);
+unsigned int M_StringHash(const char *string);
 char *uppercase(const char *str);
 char *lowercase(char *str);
 char *titlecase(const char *str);
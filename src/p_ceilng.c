@@ -45,6 +45,8 @@
 // the list of ceilings currently moving, including crushers
 ceilinglist_t   *activeceilings;
 
+slab_t          ceilingslab = { "ceiling_t", sizeof(ceiling_t), PU_LEVSPEC };
+
 static void P_GradualLightingToCeiling(ceiling_t *ceiling)
 {
     sector_t        *sector = ceiling->sector;
@@ -263,7 +265,7 @@ manual_ceiling:
 
         // new ceiling thinker
         rtn = true;
-        ceiling = Z_Calloc(1, sizeof(*ceiling), PU_LEVSPEC, NULL);
+        ceiling = Z_SlabCalloc(&ceilingslab);
 
         ceiling->thinker.function = &T_MoveCeiling;
         P_AddThinker(&ceiling->thinker);
@@ -45,6 +45,8 @@
 #include "s_sound.h"
 #include "z_zone.h"
 
+slab_t  doorslab = { "vldoor_t", sizeof(vldoor_t), PU_LEVSPEC };
+
 static void T_GradualLightingToDoor(vldoor_t *door)
 {
     sector_t        *sec = door->sector;
@@ -273,7 +275,7 @@ bool EV_DoLockedDoor(line_t *line, vldoor_e type, mobj_t *thing, fixed_t speed)
                         (M_StringCompare(playername, playername_default) ? "" : "s"), s_PD_KEYCARD);
                 }
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return false;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -315,7 +317,7 @@ bool EV_DoLockedDoor(line_t *line, vldoor_e type, mobj_t *thing, fixed_t speed)
                         (M_StringCompare(playername, playername_default) ? "" : "s"), s_PD_KEYCARD);
                 }
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return false;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -357,7 +359,7 @@ bool EV_DoLockedDoor(line_t *line, vldoor_e type, mobj_t *thing, fixed_t speed)
                         (M_StringCompare(playername, playername_default) ? "" : "s"), s_PD_KEYCARD);
                 }
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return false;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -405,7 +407,7 @@ manual_door:
 
         // new door thinker
         rtn = true;
-        door = Z_Calloc(1, sizeof(*door), PU_LEVSPEC, NULL);
+        door = Z_SlabCalloc(&doorslab);
 
         door->thinker.function = &T_VerticalDoor;
         P_AddThinker(&door->thinker);
@@ -539,7 +541,7 @@ void EV_VerticalDoor(line_t *line, mobj_t *thing)
                         (M_StringCompare(playername, playername_default) ? "" : "s"), s_PD_KEYCARD);
                 }
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -584,7 +586,7 @@ void EV_VerticalDoor(line_t *line, mobj_t *thing)
                         (M_StringCompare(playername, playername_default) ? "" : "s"), s_PD_KEYCARD);
                 }
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -629,7 +631,7 @@ void EV_VerticalDoor(line_t *line, mobj_t *thing)
                         (M_StringCompare(playername, playername_default) ? "" : "s"), s_PD_KEYCARD);
                 }
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -703,7 +705,7 @@ void EV_VerticalDoor(line_t *line, mobj_t *thing)
     }
 
     // new door thinker
-    door = Z_Calloc(1, sizeof(*door), PU_LEVSPEC, NULL);
+    door = Z_SlabCalloc(&doorslab);
 
     door->thinker.function = &T_VerticalDoor;
     P_AddThinker(&door->thinker);
@@ -766,7 +768,7 @@ void EV_VerticalDoor(line_t *line, mobj_t *thing)
 //
 void P_SpawnDoorCloseIn30(sector_t *sec)
 {
-    vldoor_t    *door = Z_Calloc(1, sizeof(*door), PU_LEVSPEC, NULL);
+    vldoor_t    *door = Z_SlabCalloc(&doorslab);
 
     door->thinker.function = &T_VerticalDoor;
     P_AddThinker(&door->thinker);
@@ -785,7 +787,7 @@ void P_SpawnDoorCloseIn30(sector_t *sec)
 //
 void P_SpawnDoorRaiseIn5Mins(sector_t *sec)
 {
-    vldoor_t    *door = Z_Calloc(1, sizeof(*door), PU_LEVSPEC, NULL);
+    vldoor_t    *door = Z_SlabCalloc(&doorslab);
 
     door->thinker.function = &T_VerticalDoor;
     P_AddThinker(&door->thinker);
@@ -67,41 +67,54 @@ void A_Fall(mobj_t *actor, player_t *player, pspdef_t *psp);
 //
 
 //
-// P_RecursiveSound
-// Called by P_NoiseAlert.
-// Recursively traverse adjacent sectors,
-// sound blocking lines cut off traversal.
-//
-// killough 05/05/98: reformatted, cleaned up
+// P_SoundLinkOpen
+// Returns whether sound can pass through the line between two sectors,
+// only checking the line's opening again if either sector has moved since.
 //
-static void P_RecursiveSound(sector_t *sec, const int soundblocks, mobj_t *soundtarget)
+static bool P_SoundLinkOpen(soundlink_t *link)
 {
-    // wake up all monsters in this sector
-    if (sec->validcount == validcount && sec->soundtraversed <= soundblocks + 1)
-        return;         // already flooded
+    line_t  *line = link->line;
 
-    sec->validcount = validcount;
-    sec->soundtraversed = soundblocks + 1;
-    P_SetTarget(&sec->soundtarget, soundtarget);
-
-    for (int i = 0; i < sec->linecount; i++)
+    if (link->checkedtime <= line->frontsector->oldgametime
+        || link->checkedtime <= line->backsector->oldgametime)
     {
-        line_t      *line = sec->lines[i];
-        const int   flags = line->flags;
+        P_LineOpening(line);
+        link->open = (openrange > 0);
+        link->checkedtime = gametime;
+    }
 
-        if (!(flags & ML_TWOSIDED))
-            continue;
+    return link->open;
+}
 
-        P_LineOpening(line);
+//
+// P_FloodSound
+// Called by P_NoiseAlert.
+// Flood outwards from the sectors queued in soundqueue[head..tail),
+// marking each sector reached with soundtraversed. Sound blocking lines
+// cut off traversal. Returns the new end of the queue.
+//
+static int P_FloodSound(int head, int tail, const int soundtraversed, mobj_t *soundtarget)
+{
+    while (head < tail)
+    {
+        sector_t    *sec = soundqueue[head++];
+
+        for (int i = 0; i < sec->numsoundlinks; i++)
+        {
+            soundlink_t *link = &sec->soundlinks[i];
+            sector_t    *other = link->sector;
 
-        if (openrange <= 0)
-            continue;   // closed door
+            if (link->soundblock || other->validcount == validcount || !P_SoundLinkOpen(link))
+                continue;
 
-        if (!(flags & ML_SOUNDBLOCK))
-            P_RecursiveSound(sides[line->sidenum[(sides[line->sidenum[0]].sector == sec)]].sector, soundblocks, soundtarget);
-        else if (!soundblocks)
-            P_RecursiveSound(sides[line->sidenum[(sides[line->sidenum[0]].sector == sec)]].sector, 1, soundtarget);
+            other->validcount = validcount;
+            other->soundtraversed = soundtraversed;
+            P_SetTarget(&other->soundtarget, soundtarget);
+            soundqueue[tail++] = other;
+        }
     }
+
+    return tail;
 }
 
 //
@@ -109,14 +122,57 @@ static void P_RecursiveSound(sector_t *sec, const int soundblocks, mobj_t *sound
 // If a monster yells at the player,
 // it will alert other monsters to the player.
 //
+// Wakes up all monsters in the sectors the sound reaches without crossing
+// a sound blocking line, then all monsters in the sectors it reaches
+// crossing only one. Done breadth-first instead of recursively, but every
+// sector ends up with the same soundtraversed it always did.
+//
 void P_NoiseAlert(mobj_t *target)
 {
+    sector_t    *sec = target->subsector->sector;
+    int         tail;
+    int         end;
+
     // [BH] don't alert if notarget CCMD is enabled
     if (target->player && (viewplayer->cheats & CF_NOTARGET))
         return;
 
     validcount++;
-    P_RecursiveSound(target->subsector->sector, 0, target);
+
+    sec->validcount = validcount;
+    sec->soundtraversed = 1;
+    P_SetTarget(&sec->soundtarget, target);
+    soundqueue[0] = sec;
+    end = P_FloodSound(0, 1, 1, target);
+
+    // cross a single sound blocking line from anywhere already reached
+    tail = end;
+
+    for (int i = 0; i < end; i++)
+    {
+        sec = soundqueue[i];
+
+        for (int j = 0; j < sec->numsoundlinks; j++)
+        {
+            soundlink_t *link = &sec->soundlinks[j];
+            sector_t    *other = link->sector;
+
+            if (!link->soundblock || other->validcount == validcount || !P_SoundLinkOpen(link))
+                continue;
+
+            other->validcount = validcount;
+            other->soundtraversed = 2;
+            P_SetTarget(&other->soundtarget, target);
+            soundqueue[tail++] = other;
+        }
+    }
+
+    P_FloodSound(end, tail, 2, target);
+
+    // wake any dormant monsters that heard it
+    for (int i = numdormantmobjs - 1; i >= 0; i--)
+        if (dormantmobjs[i]->subsector->sector->validcount == validcount)
+            P_WakeMobj(dormantmobjs[i]);
 }
 
 //
@@ -343,6 +399,7 @@ static bool P_Move(mobj_t *actor, const int dropoff)    // killough 09/12/98
         {
             actor->x = origx;
             actor->y = origy;
+            P_UpdateBlockThing(actor);
             movefactor *= FRACUNIT / ORIG_FRICTION_FACTOR / 4;
             actor->momx += FixedMul(deltax, movefactor);
             actor->momy += FixedMul(deltay, movefactor);
@@ -1270,6 +1327,7 @@ void A_SkelMissile(mobj_t *actor, player_t *player, pspdef_t *psp)
 
     mo->x += mo->momx;
     mo->y += mo->momy;
+    P_UpdateBlockThing(mo);
     P_SetTarget(&mo->tracer, target);
 }
 
@@ -1475,6 +1533,7 @@ static bool P_HealCorpse(mobj_t *actor, int radius, statenum_t healstate, sfxnum
                         // [BH] fix <https://doomwiki.org/wiki/Ghost_monster>
                         corpsehit->height = info->height;
                         corpsehit->radius = info->radius;
+                        P_UpdateBlockThing(corpsehit);
                     }
 
                     // killough 07/18/98: friendliness is transferred from AV to raised corpse
@@ -2585,6 +2644,7 @@ void A_MonsterProjectile(mobj_t *actor, player_t *player, pspdef_t *psp)
     mo->x += FixedMul(actor->state->args[3], finecosine[an]);
     mo->y += FixedMul(actor->state->args[3], finesine[an]);
     mo->z += actor->state->args[4];
+    P_UpdateBlockThing(mo);
 
     // always set the 'tracer' field, so this pointer
     // can be used to fire seeker missiles at will.
@@ -42,6 +42,8 @@
 #include "s_sound.h"
 #include "z_zone.h"
 
+slab_t  floorslab = { "floormove_t", sizeof(floormove_t), PU_LEVSPEC };
+
 //
 // FLOORS
 //
@@ -54,6 +56,9 @@ result_e T_MovePlane(sector_t *sector, const fixed_t speed, fixed_t dest,
 {
     sector->oldgametime = gametime;
 
+    // heights are about to change, so forget any lines of sight through them
+    sightcacheepoch++;
+
     switch (floororceiling)
     {
         case 0:
@@ -362,7 +367,7 @@ manual_floor:
 
         // new floor thinker
         rtn = true;
-        floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+        floor = Z_SlabCalloc(&floorslab);
 
         floor->thinker.function = &T_MoveFloor;
         P_AddThinker(&floor->thinker);
@@ -716,7 +721,7 @@ manual_stair:
 
         // new floor thinker
         rtn = true;
-        floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+        floor = Z_SlabCalloc(&floorslab);
 
         floor->thinker.function = &T_MoveFloor;
         P_AddThinker(&floor->thinker);
@@ -762,7 +767,7 @@ manual_stair:
 
                 sec = tsec;
                 secnum = tsec->id;
-                floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+                floor = Z_SlabCalloc(&floorslab);
 
                 floor->thinker.function = &T_MoveFloor;
                 P_AddThinker(&floor->thinker);
@@ -108,7 +108,7 @@ manual_floor:
 
         // new floor thinker
         rtn = true;
-        floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+        floor = Z_SlabCalloc(&floorslab);
 
         floor->thinker.function = &T_MoveFloor;
         P_AddThinker(&floor->thinker);
@@ -311,7 +311,7 @@ manual_ceiling:
 
         // new ceiling thinker
         rtn = true;
-        ceiling = Z_Calloc(1, sizeof(*ceiling), PU_LEVSPEC, NULL);
+        ceiling = Z_SlabCalloc(&ceilingslab);
 
         ceiling->thinker.function = &T_MoveCeiling;
         P_AddThinker(&ceiling->thinker);
@@ -521,7 +521,7 @@ manual_lift:
 
         // Setup the plat thinker
         rtn = true;
-        plat = Z_Calloc(1, sizeof(*plat), PU_LEVSPEC, NULL);
+        plat = Z_SlabCalloc(&platslab);
 
         plat->thinker.function = &T_PlatRaise;
         P_AddThinker(&plat->thinker);
@@ -680,7 +680,7 @@ manual_stair:
 
         // new floor thinker
         rtn = true;
-        floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+        floor = Z_SlabCalloc(&floorslab);
 
         floor->thinker.function = &T_MoveFloor;
         P_AddThinker(&floor->thinker);
@@ -787,7 +787,7 @@ manual_stair:
 
                 sec = tsec;
                 secnum = newsecnum;
-                floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+                floor = Z_SlabCalloc(&floorslab);
 
                 floor->thinker.function = &T_MoveFloor;
                 P_AddThinker(&floor->thinker);
@@ -883,7 +883,7 @@ manual_crusher:
 
         // new ceiling thinker
         rtn = true;
-        ceiling = Z_Calloc(1, sizeof(*ceiling), PU_LEVSPEC, NULL);
+        ceiling = Z_SlabCalloc(&ceilingslab);
 
         ceiling->thinker.function = &T_MoveCeiling;
         P_AddThinker(&ceiling->thinker);
@@ -992,7 +992,7 @@ manual_locked:
 
         // new door thinker
         rtn = true;
-        door = Z_Calloc(1, sizeof(*door), PU_LEVSPEC, NULL);
+        door = Z_SlabCalloc(&doorslab);
 
         door->thinker.function = &T_VerticalDoor;
         P_AddThinker(&door->thinker);
@@ -1109,7 +1109,7 @@ manual_door:
 
         // new door thinker
         rtn = true;
-        door = Z_Calloc(1, sizeof(*door), PU_LEVSPEC, NULL);
+        door = Z_SlabCalloc(&doorslab);
 
         door->thinker.function = &T_VerticalDoor;
         P_AddThinker(&door->thinker);
@@ -2185,6 +2185,9 @@ void P_DamageMobj(mobj_t *target, mobj_t *inflicter, mobj_t *source, int damage,
     mobjinfo_t          *info = &mobjinfo[type];
     bool                justhit = false;
 
+    if (target->dormant)
+        P_WakeMobj(target);
+
     if (!(flags & (MF_SHOOTABLE | MF_BOUNCES)) && (!corpse || !r_corpses_slide))
         return;
 
@@ -2428,6 +2431,7 @@ void P_ResurrectMobj(mobj_t *target)
 
     target->height = info->height;
     target->radius = info->radius;
+    P_UpdateBlockThing(target);
     target->flags = (info->flags | (target->flags & MF_FRIEND));
     target->flags2 = info->flags2;
     target->health = info->spawnhealth;
@@ -38,6 +38,7 @@
 #include "d_main.h"
 #include "m_config.h"
 #include "r_local.h"
+#include "z_zone.h"
 
 #define FOOTCLIPSIZE        (10 * FRACUNIT)
 
@@ -131,7 +132,12 @@ void P_AnimateMaxAmmo(int diff, ammotype_t type);
 #define CARDNOTFOUNDYET    -1
 #define CARDNOTINMAP        0
 
-extern int  numfriends;
+extern int      numfriends;
+extern slab_t   mobjslab;
+
+extern mobj_t           **dormantmobjs;
+extern int              numdormantmobjs;
+extern const sector_t   *dormantplayersector;
 
 void P_RespawnSpecials(void);
 
@@ -150,6 +156,11 @@ void P_RemoveBloodSplats(void);
 bool P_SetMobjState(mobj_t *mobj, statenum_t state);
 void P_MobjThinker(mobj_t *mobj);
 
+void P_CatchUpDormantMobj(mobj_t *mobj);
+void P_WakeMobj(mobj_t *mobj);
+void P_WakeDormantMobjs(void);
+void P_WakeSightedMobjs(void);
+
 void P_SpawnMoreBlood(mobj_t *mobj);
 void P_LookForFriends(void);
 mobj_t *P_SpawnMapThing(mapthing_t *mthing, const bool spawnmonsters);
@@ -228,6 +239,7 @@ void P_UnsetThingPosition(mobj_t *thing);
 void P_UnsetBloodSplatPosition(bloodsplat_t *splat);
 void P_SetThingPosition(mobj_t *thing);
 void P_SetBloodSplatPosition(bloodsplat_t *splat);
+void P_UpdateBlockThing(mobj_t *thing);
 
 void P_CheckIntercepts(void);
 
@@ -261,7 +273,12 @@ bool P_TryMove(mobj_t *thing, const fixed_t x, const fixed_t y, const int dropof
 bool P_CheckLineSide(mobj_t *actor, const fixed_t x, const fixed_t y);
 bool P_TeleportMove(mobj_t *thing, const fixed_t x, const fixed_t y, const fixed_t z, const bool boss);
 void P_SlideMove(mobj_t *mo);
+extern int          sightcacheepoch;
+extern int          sightcachehits;
+extern int          sightcachemisses;
+
 bool P_CheckSight(mobj_t *t1, mobj_t *t2);
+void P_CheckSights(mobj_t **lookers, mobj_t **targets, int count);
 bool P_CheckFOV(mobj_t *t1, mobj_t *t2, angle_t fov);
 bool P_DoorClosed(line_t *line);
 void P_UseLines(void);
@@ -296,7 +313,25 @@ extern int          bmapwidth;
 extern int          bmapheight;     // in mapblocks
 extern fixed_t      bmaporgx;
 extern fixed_t      bmaporgy;       // origin of blockmap
-extern mobj_t       **blocklinks;   // for thing chains
+// Things in each block, with copies of the fields needed to check them,
+// oldest first.
+typedef struct
+{
+    mobj_t          *mobj;
+    fixed_t         x, y;
+    fixed_t         radius;
+} blockthing_t;
+
+typedef struct blocklink_s
+{
+    blockthing_t    *things;
+    int             numthings;
+    int             maxthings;
+} blocklink_t;
+
+extern blocklink_t  *blocklinks;    // for thing lists
+
+extern sector_t     **soundqueue;   // [numsectors] size, for P_NoiseAlert()
 
 // MAES: extensions to support 512x512 blockmaps.
 extern int          blockmapxneg;
@@ -2115,6 +2115,9 @@ static void PIT_ChangeSector(mobj_t *thing)
 {
     int   flags;
 
+    if (thing->dormant)
+        P_WakeMobj(thing);
+
     if (P_ThingHeightClip(thing))
         return; // keep checking
 
@@ -2163,6 +2166,7 @@ static void PIT_ChangeSector(mobj_t *thing)
             thing->height = 0;
             thing->radius = 0;
             thing->shadowoffset = 0;
+            P_UpdateBlockThing(thing);
 
             S_StartSound(thing, sfx_slop);
         }
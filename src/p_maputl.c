@@ -174,6 +174,9 @@ void P_LineOpening(line_t *line)
 //
 void P_UnsetThingPosition(mobj_t *thing)
 {
+    if (thing->dormant)
+        P_WakeMobj(thing);
+
     if (!(thing->flags & MF_NOSECTOR))
     {
         // invisible things don't need to be in sector list
@@ -207,18 +210,23 @@ void P_UnsetThingPosition(mobj_t *thing)
     {
         // inert things don't need to be in blockmap
         //
-        // killough 08/11/98: simpler scheme using pointers-to-pointers for prev
-        // pointers, allows head node pointers to be treated like everything else
-        //
-        // Also more robust, since it doesn't depend on current position for
-        // unlinking. Old method required computing head node based on position
-        // at time of unlinking, assuming it was the same position as during
-        // linking.
-        mobj_t  *bnext;
-        mobj_t  **bprev = thing->bprev;
-
-        if (bprev && (*bprev = bnext = thing->bnext))   // unlink from blockmap
-            bnext->bprev = bprev;
+        // The thing remembers which block it was linked into, so unlinking
+        // doesn't depend on it still being at the same position. The things
+        // after it are moved down to keep the rest of the block in order.
+        blocklink_t *link = thing->blocklink;
+
+        if (link)   // unlink from blockmap
+        {
+            for (int i = link->numthings - 1; i >= 0; i--)
+                if (link->things[i].mobj == thing)
+                {
+                    memmove(&link->things[i], &link->things[i + 1],
+                        (--link->numthings - i) * sizeof(*link->things));
+                    break;
+                }
+
+            thing->blocklink = NULL;
+        }
     }
 }
 
@@ -287,24 +295,46 @@ void P_SetThingPosition(mobj_t *thing)
 
         if (blockx >= 0 && blockx < bmapwidth && blocky >= 0 && blocky < bmapheight)
         {
-            // killough 08/11/98: simpler scheme using pointer-to-pointer prev
-            // pointers, allows head nodes to be treated like everything else
-            mobj_t  **link = &blocklinks[blocky * bmapwidth + blockx];
-            mobj_t  *bnext = *link;
-
-            if ((thing->bnext = bnext))
-                bnext->bprev = &thing->bnext;
-
-            thing->bprev = link;
-            *link = thing;
+            blocklink_t     *link = &blocklinks[blocky * bmapwidth + blockx];
+            blockthing_t    *blockthing;
+
+            if (link->numthings == link->maxthings)
+                link->things = I_Realloc(link->things,
+                    (link->maxthings = (link->maxthings ? link->maxthings * 2 : 4)) * sizeof(*link->things));
+
+            blockthing = &link->things[link->numthings++];
+            blockthing->mobj = thing;
+            blockthing->x = thing->x;
+            blockthing->y = thing->y;
+            blockthing->radius = thing->radius;
+            thing->blocklink = link;
         }
         else
-        {
-            // thing is off the map
-            thing->bnext = NULL;
-            thing->bprev = NULL;
-        }
+            thing->blocklink = NULL;    // thing is off the map
     }
+
+    if (thing == viewplayer->mo)
+        P_WakeSightedMobjs();
+}
+
+//
+// P_UpdateBlockThing
+// Updates the position and radius kept for a thing in its block after they
+// have been changed without unlinking and relinking it.
+//
+void P_UpdateBlockThing(mobj_t *thing)
+{
+    blocklink_t *link = thing->blocklink;
+
+    if (link)
+        for (int i = link->numthings - 1; i >= 0; i--)
+            if (link->things[i].mobj == thing)
+            {
+                link->things[i].x = thing->x;
+                link->things[i].y = thing->y;
+                link->things[i].radius = thing->radius;
+                break;
+            }
 }
 
 //
@@ -364,77 +394,79 @@ bool P_BlockLinesIterator(const int x, const int y, bool func(line_t *))
 //
 // P_BlockThingsIterator
 //
+
+//
+// P_BlockThingsIteratorLink
+// Calls func for each thing in a block, newest first. If dx or dy is not 0,
+// the block is the one next to block (x, y) in that direction, and only
+// things overlapping block (x, y) are included.
+//
+static bool P_BlockThingsIteratorLink(const int x, const int y, const int dx, const int dy, bool func(mobj_t *))
+{
+    const blocklink_t   *link = &blocklinks[(y + dy) * bmapwidth + x + dx];
+
+    for (int i = link->numthings - 1; i >= 0; i--)
+    {
+        const blockthing_t  *thing = &link->things[i];
+        mobj_t              *mobj = thing->mobj;
+        mobj_t              *next;
+
+        if ((dx && x != ((dx < 0 ? thing->x + thing->radius : thing->x - thing->radius) - bmaporgx) >> MAPBLOCKSHIFT)
+            || (dy && y != ((dy < 0 ? thing->y + thing->radius : thing->y - thing->radius) - bmaporgy) >> MAPBLOCKSHIFT))
+            continue;
+
+        next = (i ? link->things[i - 1].mobj : NULL);
+
+        if (!func(mobj))
+            return false;
+
+        // func may have unlinked other things in this block, so find the next
+        // one again, or carry on from below this one if it has gone
+        if (next && (i > link->numthings || link->things[i - 1].mobj != next))
+        {
+            int j = MIN(i, link->numthings);
+
+            while (j > 0 && link->things[j - 1].mobj != next)
+                j--;
+
+            if (!j)
+            {
+                j = MIN(i, link->numthings - 1);
+
+                while (j >= 0 && link->things[j].mobj != mobj)
+                    j--;
+
+                if (j < 0)
+                    j = MIN(i, link->numthings);
+            }
+
+            i = j;
+        }
+    }
+
+    return true;
+}
+
 bool P_BlockThingsIterator(const int x, const int y, bool func(mobj_t *))
 {
     if (x < 0 || y < 0 || x >= bmapwidth || y >= bmapheight)
         return true;
 
-    for (mobj_t *mobj = blocklinks[y * bmapwidth + x]; mobj; mobj = mobj->bnext)
-        if (!func(mobj))
-            return false;
+    if (!P_BlockThingsIteratorLink(x, y, 0, 0, func))
+        return false;
 
     if (func == &PIT_RadiusAttack)
         return true;
 
     // Blockmap bug fix by Terry Hearst
-
-    // (-1, -1)
-    if (x > 0 && y > 0)
-        for (mobj_t *mobj = blocklinks[(y - 1) * bmapwidth + x - 1]; mobj; mobj = mobj->bnext)
-            if (x == (mobj->x + mobj->radius - bmaporgx) >> MAPBLOCKSHIFT
-                && y == (mobj->y + mobj->radius - bmaporgy) >> MAPBLOCKSHIFT
-                && !func(mobj))
-                    return false;
-
-    // (0, -1)
-    if (y > 0)
-        for (mobj_t *mobj = blocklinks[(y - 1) * bmapwidth + x]; mobj; mobj = mobj->bnext)
-            if (y == (mobj->y + mobj->radius - bmaporgy) >> MAPBLOCKSHIFT && !func(mobj))
-                    return false;
-
-    // (1, -1)
-    if (x < bmapwidth - 1 && y > 0)
-        for (mobj_t *mobj = blocklinks[(y - 1) * bmapwidth + x + 1]; mobj; mobj = mobj->bnext)
-            if (x == (mobj->x - mobj->radius - bmaporgx) >> MAPBLOCKSHIFT
-                && y == (mobj->y + mobj->radius - bmaporgy) >> MAPBLOCKSHIFT
-                && !func(mobj))
-                    return false;
-
-    // (1, 0)
-    if (x < bmapwidth - 1)
-        for (mobj_t *mobj = blocklinks[y * bmapwidth + x + 1]; mobj; mobj = mobj->bnext)
-            if (x == (mobj->x - mobj->radius - bmaporgx) >> MAPBLOCKSHIFT && !func(mobj))
-                    return false;
-
-    // (1, 1)
-    if (x < bmapwidth - 1 && y < bmapheight - 1)
-        for (mobj_t *mobj = blocklinks[(y + 1) * bmapwidth + x + 1]; mobj; mobj = mobj->bnext)
-            if (x == (mobj->x - mobj->radius - bmaporgx) >> MAPBLOCKSHIFT
-                && y == (mobj->y - mobj->radius - bmaporgy) >> MAPBLOCKSHIFT
-                && !func(mobj))
-                    return false;
-
-    // (0, 1)
-    if (y < bmapheight - 1)
-        for (mobj_t *mobj = blocklinks[(y + 1) * bmapwidth + x]; mobj; mobj = mobj->bnext)
-            if (y == (mobj->y - mobj->radius - bmaporgy) >> MAPBLOCKSHIFT && !func(mobj))
-                    return false;
-
-    // (-1, 1)
-    if (x > 0 && y < bmapheight - 1)
-        for (mobj_t *mobj = blocklinks[(y + 1) * bmapwidth + x - 1]; mobj; mobj = mobj->bnext)
-            if (x == (mobj->x + mobj->radius - bmaporgx) >> MAPBLOCKSHIFT
-                && y == (mobj->y - mobj->radius - bmaporgy) >> MAPBLOCKSHIFT
-                && !func(mobj))
-                    return false;
-
-    // (-1, 0)
-    if (x > 0)
-        for (mobj_t *mobj = blocklinks[y * bmapwidth + x - 1]; mobj; mobj = mobj->bnext)
-            if (x == (mobj->x + mobj->radius - bmaporgx) >> MAPBLOCKSHIFT && !func(mobj))
-                    return false;
-
-    return true;
+    return ((x <= 0 || y <= 0 || P_BlockThingsIteratorLink(x, y, -1, -1, func))
+        && (y <= 0 || P_BlockThingsIteratorLink(x, y, 0, -1, func))
+        && (x >= bmapwidth - 1 || y <= 0 || P_BlockThingsIteratorLink(x, y, 1, -1, func))
+        && (x >= bmapwidth - 1 || P_BlockThingsIteratorLink(x, y, 1, 0, func))
+        && (x >= bmapwidth - 1 || y >= bmapheight - 1 || P_BlockThingsIteratorLink(x, y, 1, 1, func))
+        && (y >= bmapheight - 1 || P_BlockThingsIteratorLink(x, y, 0, 1, func))
+        && (x <= 0 || y >= bmapheight - 1 || P_BlockThingsIteratorLink(x, y, -1, 1, func))
+        && (x <= 0 || P_BlockThingsIteratorLink(x, y, -1, 0, func)));
 }
 
 //
@@ -609,29 +641,63 @@ static bool PIT_AddThingIntercepts(mobj_t *thing)
 // P_TraverseIntercepts
 // Returns true if the traverser function returns true for all lines.
 //
-static bool P_TraverseIntercepts(traverser_t func, const fixed_t maxfrac)
+// The intercepts are kept in a binary min-heap rather than scanned for the
+// nearest one at every step. Equal fracs are ordered by when they were
+// added, so they are traversed in the same order as before.
+//
+static int  *interceptheap;
+
+static bool P_InterceptBefore(const int a, const int b)
+{
+    return (intercepts[a].frac < intercepts[b].frac || (intercepts[a].frac == intercepts[b].frac && a < b));
+}
+
+static void P_SiftInterceptDown(int i, const int count)
 {
-    size_t      count = intercept_p - intercepts;
-    intercept_t *in = NULL;
+    const int   in = interceptheap[i];
+    int         child;
 
-    while (count--)
+    while ((child = i * 2 + 1) < count)
     {
-        fixed_t dist = FIXED_MAX;
+        if (child + 1 < count && P_InterceptBefore(interceptheap[child + 1], interceptheap[child]))
+            child++;
 
-        for (intercept_t *scan = intercepts; scan < intercept_p; scan++)
-            if (scan->frac < dist)
-            {
-                dist = scan->frac;
-                in = scan;
-            }
+        if (!P_InterceptBefore(interceptheap[child], in))
+            break;
 
-        if (dist > maxfrac)
+        interceptheap[i] = interceptheap[child];
+        i = child;
+    }
+
+    interceptheap[i] = in;
+}
+
+static bool P_TraverseIntercepts(traverser_t func, const fixed_t maxfrac)
+{
+    static int  maxcount;
+    int         count = (int)(intercept_p - intercepts);
+
+    if (count > maxcount)
+        interceptheap = I_Realloc(interceptheap, (maxcount = count) * sizeof(*interceptheap));
+
+    for (int i = 0; i < count; i++)
+        interceptheap[i] = i;
+
+    for (int i = count / 2 - 1; i >= 0; i--)
+        P_SiftInterceptDown(i, count);
+
+    while (count)
+    {
+        intercept_t *in = &intercepts[interceptheap[0]];
+
+        if (in->frac > maxfrac)
             return true;    // checked everything in range
 
-        if (!in || !func(in))
-            return false;   // don't bother going farther
+        interceptheap[0] = interceptheap[--count];
+        P_SiftInterceptDown(0, count);
 
-        in->frac = FIXED_MAX;
+        if (!func(in))
+            return false;   // don't bother going farther
     }
 
     return true;            // everything was traversed
@@ -816,48 +882,35 @@ int P_GetSafeBlockY(int coord)
 //
 static mobj_t *RoughBlockCheck(mobj_t *mo, const int index, const angle_t fov)
 {
-    mobj_t  *link = blocklinks[index];
+    const blocklink_t   *link = &blocklinks[index];
 
-    while (link)
+    for (int i = link->numthings - 1; i >= 0; i--)
     {
+        mobj_t  *thing = link->things[i].mobj;
+
         // skip non-shootable actors
-        if (!(link->flags & MF_SHOOTABLE))
-        {
-            link = link->bnext;
+        if (!(thing->flags & MF_SHOOTABLE))
             continue;
-        }
 
         // skip the projectile's owner
-        if (link == mo->target)
-        {
-            link = link->bnext;
+        if (thing == mo->target)
             continue;
-        }
 
         // skip actors on the same "team", unless infighting
-        if (mo->target && !((link->flags ^ mo->target->flags) & MF_FRIEND)
-            && mo->target->target != link && !(link->player && mo->target->player))
-        {
-            link = link->bnext;
+        if (mo->target && !((thing->flags ^ mo->target->flags) & MF_FRIEND)
+            && mo->target->target != thing && !(thing->player && mo->target->player))
             continue;
-        }
 
         // skip actors outside of specified FOV
-        if (fov > 0 && !P_CheckFOV(mo, link, fov))
-        {
-            link = link->bnext;
+        if (fov > 0 && !P_CheckFOV(mo, thing, fov))
             continue;
-        }
 
         // skip actors not in line of sight
-        if (!P_CheckSight(mo, link))
-        {
-            link = link->bnext;
+        if (!P_CheckSight(mo, thing))
             continue;
-        }
 
         // all good! return it.
-        return link;
+        return thing;
     }
 
     // couldn't find a valid target
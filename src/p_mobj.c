@@ -41,6 +41,7 @@
 #include "hu_stuff.h"
 #include "i_colors.h"
 #include "i_gamecontroller.h"
+#include "i_system.h"
 #include "m_config.h"
 #include "m_misc.h"
 #include "m_random.h"
@@ -54,12 +55,25 @@
 #include "w_wad.h"
 #include "z_zone.h"
 
+slab_t  mobjslab = { "mobj_t", sizeof(mobj_t), PU_LEVEL };
+
+mobj_t          **dormantmobjs;
+int             numdormantmobjs;
+const sector_t  *dormantplayersector;
+
+static int  maxdormantmobjs;
+
+void A_Look(mobj_t *actor, player_t *player, pspdef_t *psp);
+
 //
 // P_SetMobjState
 // Returns true if the mobj is still present.
 //
 bool P_SetMobjState(mobj_t *mobj, statenum_t state)
 {
+    if (mobj->dormant)
+        P_WakeMobj(mobj);
+
     do
     {
         if (state == S_NULL)
@@ -627,6 +641,156 @@ static void P_NightmareRespawn(mobj_t *mobj)
     stat_monstersrespawned = SafeAdd(stat_monstersrespawned, 1);
 }
 
+//
+// DORMANT MONSTERS
+//
+// When the dormantmonsters CVAR is on, a monster idling in its spawn states
+// where the REJECT lump says it can't see the player is put to sleep.
+// P_Ticker() then skips it, only counting the tics it misses, until
+// something disturbs it and P_WakeMobj() replays them. A_Look() would have
+// failed on every one of those tics, so only its state needs to change.
+//
+
+//
+// P_IsIdleState
+// Returns true if the states from state on loop back to it, each lasting at
+// least a tic and doing nothing but calling A_Look().
+//
+static bool P_IsIdleState(const state_t *state)
+{
+    const state_t   *st = state;
+
+    for (int i = 0; i < 16; i++)
+    {
+        if (st->tics <= 0 || (st->action && st->action != &A_Look) || st->nextstate == S_NULL)
+            return false;
+
+        if ((st = &states[st->nextstate]) == state)
+            return true;
+    }
+
+    return false;
+}
+
+//
+// P_CanMobjBeDormant
+//
+static bool P_CanMobjBeDormant(const mobj_t *mobj)
+{
+    const sector_t  *sector = mobj->subsector->sector;
+    const mobj_t    *playermo = viewplayer->mo;
+    int             pnum;
+
+    if (mobj->player || mobj->thinker.function != &P_MobjThinker || !sentient(mobj) || mobj->target || mobj->lastenemy
+        || (mobj->flags & (MF_FRIEND | MF_SKULLFLY)) || (mobj->flags2 & MF2_FEETARECLIPPED)
+        || mobj->momx || mobj->momy || mobj->momz || mobj->z != mobj->floorz
+        || mobj->nudge || mobj->threshold || mobj->pursuecount || mobj->interpolate != 1
+        || sector->soundtarget || (sector->special & KILL_MONSTERS_MASK)
+        || !playermo || !P_IsIdleState(mobj->state))
+        return false;
+
+    // and the REJECT lump must say it can't see the player from here
+    pnum = sector->id * numsectors + playermo->subsector->sector->id;
+
+    return (rejectmatrix[pnum >> 3] & (1 << (pnum & 7)));
+}
+
+//
+// P_MakeMobjDormant
+//
+static void P_MakeMobjDormant(mobj_t *mobj)
+{
+    if (numdormantmobjs == maxdormantmobjs)
+    {
+        maxdormantmobjs = (maxdormantmobjs ? maxdormantmobjs * 2 : 256);
+        dormantmobjs = I_Realloc(dormantmobjs, maxdormantmobjs * sizeof(*dormantmobjs));
+    }
+
+    mobj->dormant = true;
+    mobj->dormanttics = 0;
+    mobj->dormantindex = numdormantmobjs;
+    dormantmobjs[numdormantmobjs++] = mobj;
+}
+
+//
+// P_CatchUpDormantMobj
+// Brings the state of a dormant mobj up to date without waking it, as if it
+// had thought on every tic it was skipped.
+//
+void P_CatchUpDormantMobj(mobj_t *mobj)
+{
+    int tics = mobj->dormanttics;
+
+    mobj->dormanttics = 0;
+
+    while (tics > 0)
+    {
+        state_t *st;
+
+        if (tics < mobj->tics)
+        {
+            mobj->tics -= tics;
+            break;
+        }
+
+        tics -= mobj->tics;
+        st = &states[mobj->state->nextstate];
+        mobj->state = st;
+        mobj->tics = st->tics;
+        mobj->sprite = st->sprite;
+        mobj->frame = st->frame;
+    }
+}
+
+//
+// P_WakeMobj
+//
+void P_WakeMobj(mobj_t *mobj)
+{
+    mobj_t  *last = dormantmobjs[--numdormantmobjs];
+
+    P_CatchUpDormantMobj(mobj);
+    mobj->dormant = false;
+
+    last->dormantindex = mobj->dormantindex;
+    dormantmobjs[mobj->dormantindex] = last;
+}
+
+//
+// P_WakeDormantMobjs
+//
+void P_WakeDormantMobjs(void)
+{
+    while (numdormantmobjs)
+        P_WakeMobj(dormantmobjs[numdormantmobjs - 1]);
+}
+
+//
+// P_WakeSightedMobjs
+// Called whenever the player moves, to wake any dormant monsters that may
+// now be able to see them. The player's sector is recorded even when no
+// monsters are dormant, so any that go dormant later are checked again as
+// soon as the player leaves it.
+//
+void P_WakeSightedMobjs(void)
+{
+    const sector_t  *sector = viewplayer->mo->subsector->sector;
+    const int       id = sector->id;
+
+    if (sector == dormantplayersector)
+        return;
+
+    dormantplayersector = sector;
+
+    for (int i = numdormantmobjs - 1; i >= 0; i--)
+    {
+        const int   pnum = dormantmobjs[i]->subsector->sector->id * numsectors + id;
+
+        if (!(rejectmatrix[pnum >> 3] & (1 << (pnum & 7))))
+            P_WakeMobj(dormantmobjs[i]);
+    }
+}
+
 //
 // P_MobjThinker
 //
@@ -747,6 +911,9 @@ void P_MobjThinker(mobj_t *mobj)
             && ++mobj->movecount >= 12 * TICRATE && !(maptime & 31) && M_Random() <= 4)
             P_NightmareRespawn(mobj);
     }
+
+    if (dormantmonsters && P_CanMobjBeDormant(mobj))
+        P_MakeMobjDormant(mobj);
 }
 
 //
@@ -765,7 +932,7 @@ void P_SetShadowColumnFunction(mobj_t *mobj)
 //
 mobj_t *P_SpawnMobj(const fixed_t x, const fixed_t y, const fixed_t z, const mobjtype_t type)
 {
-    mobj_t      *mobj = Z_Calloc(1, sizeof(*mobj), PU_LEVEL, NULL);
+    mobj_t      *mobj = Z_SlabCalloc(&mobjslab);
     mobjinfo_t  *info = &mobjinfo[type];
     state_t     *st = &states[info->spawnstate];
     sector_t    *sector;
@@ -843,6 +1010,9 @@ void P_RemoveMobj(mobj_t *mobj)
 {
     const int   flags = mobj->flags;
 
+    if (mobj->dormant)
+        P_WakeMobj(mobj);
+
     if ((flags & MF_SPECIAL) && !(flags & MF_DROPPED))
     {
         itemrespawnqueue[iqueuehead] = mobj->spawnpoint;
@@ -1387,7 +1557,7 @@ mobj_t *P_SpawnMapThing(mapthing_t *mthing, const bool spawnmonsters)
 //
 void P_SpawnPuff(const fixed_t x, const fixed_t y, const fixed_t z, const angle_t angle)
 {
-    mobj_t      *th = Z_Calloc(1, sizeof(*th), PU_LEVEL, NULL);
+    mobj_t      *th = Z_SlabCalloc(&mobjslab);
     mobjinfo_t  *info = &mobjinfo[MT_PUFF];
     state_t     *st = &states[info->spawnstate];
     sector_t    *sector;
@@ -1461,7 +1631,7 @@ void P_SpawnBlood(const fixed_t x, const fixed_t y, const fixed_t z, angle_t ang
 
         for (int i = (damage >> 2) + 1; i > 0; i--)
         {
-            mobj_t      *th = Z_Calloc(1, sizeof(*th), PU_LEVEL, NULL);
+            mobj_t      *th = Z_SlabCalloc(&mobjslab);
             sector_t    *sector;
 
             th->type = MT_BLOOD;
@@ -1604,6 +1774,7 @@ bool P_CheckMissileSpawn(mobj_t *th)
     th->x += (th->momx >> 1);
     th->y += (th->momy >> 1);
     th->z += (th->momz >> 1);
+    P_UpdateBlockThing(th);
 
     // killough 08/12/98: for non-missile objects (e.g. grenades)
     if (!(th->flags & MF_MISSILE))
@@ -396,9 +396,8 @@ typedef struct mobj_s
     int                 frame;                  // might be ORed with FF_FULLBRIGHT
 
     // Interaction info, by BLOCKMAP.
-    // Links in blocks (if needed).
-    struct mobj_s       *bnext;
-    struct mobj_s       **bprev;                // killough 08/11/98: change to ptr-to-ptr
+    // Block it is in (if needed).
+    struct blocklink_s  *blocklink;
 
     struct subsector_s  *subsector;
 
@@ -421,6 +420,12 @@ typedef struct mobj_s
 
     int                 tics;                   // state tic counter
     state_t             *state;
+
+    // Set while P_Ticker() is skipping this mobj, counting the tics it
+    // misses in dormanttics.
+    bool                dormant;
+    int                 dormanttics;
+    int                 dormantindex;           // in dormantmobjs[]
     int                 flags;
     int                 flags2;
     int                 mbf21flags;
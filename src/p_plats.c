@@ -42,6 +42,8 @@
 
 platlist_t  *activeplats;   // killough 02/14/98: made global again
 
+slab_t      platslab = { "plat_t", sizeof(plat_t), PU_LEVSPEC };
+
 void T_PlatStay(plat_t *plat) {}
 
 //
@@ -197,7 +199,7 @@ manual_plat:
 
         // Find lowest and highest floors around sector
         rtn = true;
-        plat = Z_Calloc(1, sizeof(*plat), PU_LEVSPEC, NULL);
+        plat = Z_SlabCalloc(&platslab);
 
         plat->thinker.function = &T_PlatRaise;
         P_AddThinker(&plat->thinker);
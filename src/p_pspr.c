@@ -1002,6 +1002,7 @@ void A_WeaponProjectile(mobj_t *actor, player_t *player, pspdef_t *psp)
     mo->x += FixedMul(state->args[3], finecosine[an]);
     mo->y += FixedMul(state->args[3], finesine[an]);
     mo->z += state->args[4];
+    P_UpdateBlockThing(mo);
 
     // set tracer to the player's autoaim target,
     // so player seeker missiles prioritizing the
@@ -1281,6 +1281,9 @@ void P_UnarchiveWorld(void)
 //
 void P_ArchiveThinkers(void)
 {
+    // bring the states of any dormant monsters up to date
+    P_WakeDormantMobjs();
+
     // save off the current thinkers
     for (thinker_t *th = thinkers[th_mobj].cnext; th != &thinkers[th_mobj]; th = th->cnext)
         if (th->function != &P_RemoveThinkerDelayed)
@@ -1338,6 +1341,7 @@ void P_UnarchiveThinkers(void)
     }
 
     P_InitThinkers();
+    P_RemoveScrollers();
 
     thingindex = 0;
 
@@ -1353,7 +1357,7 @@ void P_UnarchiveThinkers(void)
         {
             case tc_mobj:
             {
-                mobj_t  *mobj = Z_Calloc(1, sizeof(*mobj), PU_LEVEL, NULL);
+                mobj_t  *mobj = Z_SlabCalloc(&mobjslab);
 
                 saveg_read_mobj_t(mobj);
 
@@ -1436,105 +1440,121 @@ void P_RestoreTargets(void)
     }
 }
 
+//
+// P_ArchiveScrollers
+// Scrollers in a list share their control sector's last known height.
+//
+static void P_ArchiveScrollers(const scrollerlist_t *list)
+{
+    for (int i = 0; i < list->count; i++)
+    {
+        scroll_t    *scroller = list->scrollers[i];
+
+        if (scroller->control != -1)
+            scroller->lastheight = scrollcontrols[scroller->control].lastheight;
+
+        saveg_write8(tc_scroll);
+        saveg_write_scroll_t(scroller);
+    }
+}
+
 //
 // P_ArchiveSpecials
 //
 void P_ArchiveSpecials(void)
 {
-    int         i = maxbuttons;
-    button_t    *button = buttonlist;
-
     // save off the current thinkers
-    for (thinker_t *th = thinkers[th_misc].cnext; th != &thinkers[th_misc]; th = th->cnext)
-    {
-        if (th->function == &T_CeilingStay)
-        {
-            for (ceilinglist_t *ceilinglist = activeceilings; ceilinglist; ceilinglist = ceilinglist->next)
-                if (ceilinglist->ceiling == (ceiling_t *)th)
-                {
-                    saveg_write8(tc_ceiling);
-                    saveg_write_ceiling_t((ceiling_t *)th);
-                    break;
-                }
-        }
-        else if (th->function == &T_MoveCeiling)
-        {
-            saveg_write8(tc_ceiling);
-            saveg_write_ceiling_t((ceiling_t *)th);
-        }
-        else if (th->function == &T_VerticalDoor)
-        {
-            saveg_write8(tc_door);
-            saveg_write_vldoor_t((vldoor_t *)th);
-        }
-        else if (th->function == &T_MoveFloor)
-        {
-            saveg_write8(tc_floor);
-            saveg_write_floormove_t((floormove_t *)th);
-        }
-        else if (th->function == &T_PlatStay)
-        {
-            // [jeff-d] save height of moving platforms
-            for (platlist_t *platlist = activeplats; platlist; platlist = platlist->next)
-                if (platlist->plat == (plat_t *)th)
-                {
-                    saveg_write8(tc_plat);
-                    saveg_write_plat_t((plat_t *)th);
-                    break;
-                }
-        }
-        else if (th->function == &T_PlatRaise)
-        {
-            saveg_write8(tc_plat);
-            saveg_write_plat_t((plat_t *)th);
-        }
-        else if (th->function == &T_LightFlash)
-        {
-            saveg_write8(tc_flash);
-            saveg_write_lightflash_t((lightflash_t *)th);
-        }
-        else if (th->function == &T_StrobeFlash)
-        {
-            saveg_write8(tc_strobe);
-            saveg_write_strobe_t((strobe_t *)th);
-        }
-        else if (th->function == &T_Glow)
-        {
-            saveg_write8(tc_glow);
-            saveg_write_glow_t((glow_t *)th);
-        }
-        else if (th->function == &T_FireFlicker)
-        {
-            saveg_write8(tc_fireflicker);
-            saveg_write_fireflicker_t((fireflicker_t *)th);
-        }
-        else if (th->function == &T_MoveElevator)
-        {
-            saveg_write8(tc_elevator);
-            saveg_write_elevator_t((elevator_t *)th);
-        }
-        else if (th->function == &T_Scroll)
+    for (int j = th_mobj + 1; j < NUMTHCLASS; j++)
+        for (thinker_t *th = thinkers[j].cnext; th != &thinkers[j]; th = th->cnext)
         {
-            saveg_write8(tc_scroll);
-            saveg_write_scroll_t((scroll_t *)th);
-        }
-        else if (th->function == &T_Pusher)
-        {
-            saveg_write8(tc_pusher);
-            saveg_write_pusher_t((pusher_t *)th);
+            if (th->function == &T_CeilingStay)
+            {
+                for (ceilinglist_t *ceilinglist = activeceilings; ceilinglist; ceilinglist = ceilinglist->next)
+                    if (ceilinglist->ceiling == (ceiling_t *)th)
+                    {
+                        saveg_write8(tc_ceiling);
+                        saveg_write_ceiling_t((ceiling_t *)th);
+                        break;
+                    }
+            }
+            else if (th->function == &T_MoveCeiling)
+            {
+                saveg_write8(tc_ceiling);
+                saveg_write_ceiling_t((ceiling_t *)th);
+            }
+            else if (th->function == &T_VerticalDoor)
+            {
+                saveg_write8(tc_door);
+                saveg_write_vldoor_t((vldoor_t *)th);
+            }
+            else if (th->function == &T_MoveFloor)
+            {
+                saveg_write8(tc_floor);
+                saveg_write_floormove_t((floormove_t *)th);
+            }
+            else if (th->function == &T_PlatStay)
+            {
+                // [jeff-d] save height of moving platforms
+                for (platlist_t *platlist = activeplats; platlist; platlist = platlist->next)
+                    if (platlist->plat == (plat_t *)th)
+                    {
+                        saveg_write8(tc_plat);
+                        saveg_write_plat_t((plat_t *)th);
+                        break;
+                    }
+            }
+            else if (th->function == &T_PlatRaise)
+            {
+                saveg_write8(tc_plat);
+                saveg_write_plat_t((plat_t *)th);
+            }
+            else if (th->function == &T_LightFlash)
+            {
+                saveg_write8(tc_flash);
+                saveg_write_lightflash_t((lightflash_t *)th);
+            }
+            else if (th->function == &T_StrobeFlash)
+            {
+                saveg_write8(tc_strobe);
+                saveg_write_strobe_t((strobe_t *)th);
+            }
+            else if (th->function == &T_Glow)
+            {
+                saveg_write8(tc_glow);
+                saveg_write_glow_t((glow_t *)th);
+            }
+            else if (th->function == &T_FireFlicker)
+            {
+                saveg_write8(tc_fireflicker);
+                saveg_write_fireflicker_t((fireflicker_t *)th);
+            }
+            else if (th->function == &T_MoveElevator)
+            {
+                saveg_write8(tc_elevator);
+                saveg_write_elevator_t((elevator_t *)th);
+            }
+            else if (th->function == &T_Scroll)
+            {
+                saveg_write8(tc_scroll);
+                saveg_write_scroll_t((scroll_t *)th);
+            }
+            else if (th->function == &T_Pusher)
+            {
+                saveg_write8(tc_pusher);
+                saveg_write_pusher_t((pusher_t *)th);
+            }
         }
-    }
 
-    do
-    {
-        if (button->btimer)
-        {
-            saveg_write8(tc_button);
-            saveg_write_button_t(button);
-        }
+    // save off the wall, floor and ceiling scrollers, which aren't thinkers
+    P_ArchiveScrollers(&sidescrollers);
+    P_ArchiveScrollers(&floorscrollers);
+    P_ArchiveScrollers(&ceilingscrollers);
 
-        button++;
-    } while (--i);
+    for (int i = 0; i < numbuttons; i++)
+    {
+        saveg_write8(tc_button);
+        saveg_write_button_t(&buttonlist[i]);
+    }
 
     // add a terminating marker
     saveg_write8(tc_endspecials);
@@ -1558,7 +1578,7 @@ void P_UnarchiveSpecials(void)
 
             case tc_ceiling:
             {
-                ceiling_t   *ceiling = Z_Calloc(1, sizeof(*ceiling), PU_LEVSPEC, NULL);
+                ceiling_t   *ceiling = Z_SlabCalloc(&ceilingslab);
 
                 saveg_read_ceiling_t(ceiling);
                 ceiling->sector->ceilingdata = ceiling;
@@ -1570,7 +1590,7 @@ void P_UnarchiveSpecials(void)
 
             case tc_door:
             {
-                vldoor_t    *door = Z_Calloc(1, sizeof(*door), PU_LEVSPEC, NULL);
+                vldoor_t    *door = Z_SlabCalloc(&doorslab);
 
                 saveg_read_vldoor_t(door);
                 door->sector->ceilingdata = door;
@@ -1581,7 +1601,7 @@ void P_UnarchiveSpecials(void)
 
             case tc_floor:
             {
-                floormove_t *floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+                floormove_t *floor = Z_SlabCalloc(&floorslab);
 
                 saveg_read_floormove_t(floor);
                 floor->sector->floordata = floor;
@@ -1592,7 +1612,7 @@ void P_UnarchiveSpecials(void)
 
             case tc_plat:
             {
-                plat_t  *plat = Z_Calloc(1, sizeof(*plat), PU_LEVSPEC, NULL);
+                plat_t  *plat = Z_SlabCalloc(&platslab);
 
                 saveg_read_plat_t(plat);
                 plat->sector->floordata = plat;
@@ -1661,9 +1681,7 @@ void P_UnarchiveSpecials(void)
                 scroll_t    *scroll = Z_Calloc(1, sizeof(*scroll), PU_LEVSPEC, NULL);
 
                 saveg_read_scroll_t(scroll);
-                scroll->thinker.function = &T_Scroll;
-                scroll->thinker.menu = (scroll->type != sc_carry);
-                P_AddThinker(&scroll->thinker);
+                P_AddScroller(scroll);
                 break;
             }
 
@@ -43,6 +43,7 @@
 #include "doomstat.h"
 #include "i_swap.h"
 #include "i_system.h"
+#include "i_timer.h"
 #include "m_argv.h"
 #include "m_bbox.h"
 #include "m_config.h"
@@ -206,7 +207,10 @@ fixed_t             bmaporgx;
 fixed_t             bmaporgy;
 
 // for thing chains
-mobj_t              **blocklinks;
+blocklink_t         *blocklinks;
+
+// sectors still to be flooded by P_NoiseAlert()
+sector_t            **soundqueue;
 
 // MAES: extensions to support 512x512 blockmaps.
 // They represent the maximum negative number which represents
@@ -2268,6 +2272,10 @@ static bool P_VerifyBlockMap(int count)
 //
 // The algorithm's complexity is on the order of nlines * total_linedef_length.
 //
+// The blocks visited by each linedef are now recorded in a single pass into
+// one contiguous array, and then scattered into the blockmap lump with a
+// counting sort, rather than growing a separate list for every block.
+//
 // Please note: This section of code is not interchangeable with TeamTNT's
 // code which attempts to fix the same problem.
 //
@@ -2330,23 +2338,22 @@ static void P_CreateBlockMap(void)
     //
     //   Starting in the starting vertex's block, do:
     //
-    //     Add linedef to current block's list, dynamically resizing it.
+    //     Record the current block, and count the linedef in it.
     //
     //     If current block is the same as the ending vertex's block, exit loop.
     //
     //     Move to an adjacent block by moving towards the ending block in
     //     either the x or y direction, to the block which contains the linedef.
+    //
+    // Then reserve space in the blockmap lump for each block's list from its
+    // count, and copy each linedef into the lists of the blocks it visited.
     {
-        // blocklist structure
-        typedef struct
-        {
-            size_t  n;
-            size_t  nalloc;
-            int     *list;
-        } bmap_t;
-
-        unsigned int    tot = bmapwidth * bmapheight;           // size of blockmap
-        bmap_t          *bmap = calloc(tot, sizeof(*bmap));     // array of blocklists
+        unsigned int    tot = bmapwidth * bmapheight;                           // size of blockmap
+        int             *counts = calloc(tot, sizeof(*counts));                 // linedefs in each block
+        int             *firstcell = malloc(((size_t)numlines + 1) * sizeof(*firstcell));
+        unsigned int    *cells = NULL;                                          // blocks visited by all linedefs
+        size_t          numcells = 0;
+        size_t          maxcells = 0;
 
         for (int i = 0; i < numlines; i++)
         {
@@ -2366,31 +2373,33 @@ static void P_CreateBlockMap(void)
                                 - (((y >> MAPBTOFRAC) << MAPBTOFRAC) + (dy > 0 ? MAPBLOCKUNITS - 1 : 0) - y)
                                 * (adx = ABS(adx)) * dy));
 
-            // starting block, and pointer to its blocklist structure
+            // starting block
             unsigned int    b = (y >> MAPBTOFRAC) * bmapwidth + (x >> MAPBTOFRAC);
 
             // ending block
             int             bend = (((lines[i].v2->y >> FRACBITS) - miny) >> MAPBTOFRAC) * bmapwidth
                                 + (((lines[i].v2->x >> FRACBITS) - minx) >> MAPBTOFRAC);
 
-            // delta for pointer when moving across y
+            // delta for block when moving across y
             dy *= bmapwidth;
 
             // deltas for diff inside the loop
             adx <<= MAPBTOFRAC;
             ady <<= MAPBTOFRAC;
 
+            firstcell[i] = (int)numcells;
+
             // Now we simply iterate block-by-block until we reach the end block.
             while (b < tot) // failsafe -- should ALWAYS be true
             {
-                bmap_t  *bp = &bmap[b];
-
-                // Increase size of allocated list if necessary
-                if (bp->n >= bp->nalloc)
-                    bp->list = I_Realloc(bp->list, (bp->nalloc = (bp->nalloc ? bp->nalloc * 2 : 8)) * sizeof(*bp->list));
+                // Increase size of visited blocks if necessary
+                if (numcells >= maxcells)
+                    cells = I_Realloc(cells, (maxcells = (maxcells ? maxcells * 2 : (size_t)numlines * 4 + 64))
+                        * sizeof(*cells));
 
-                // Add linedef to end of list
-                bp->list[bp->n++] = i;
+                // Record the block, and count the linedef in it
+                cells[numcells++] = b;
+                counts[b]++;
 
                 // If we have reached the last block, exit
                 if (b == bend)
@@ -2410,6 +2419,8 @@ static void P_CreateBlockMap(void)
             }
         }
 
+        firstcell[numlines] = (int)numcells;
+
         // Compute the total size of the blockmap.
         //
         // Compression of empty blocks is performed by reserving two offset words
@@ -2419,9 +2430,9 @@ static void P_CreateBlockMap(void)
         {
             size_t  count = (size_t)tot + 6;    // we need at least 1 word per block, plus reserved's
 
-            for (int i = 0; (unsigned int)i < tot; i++)
-                if (bmap[i].n)
-                    count += bmap[i].n + 2;     // 1 header word + 1 trailer word + blocklist
+            for (unsigned int i = 0; i < tot; i++)
+                if (counts[i])
+                    count += (size_t)counts[i] + 2; // 1 header word + 1 trailer word + blocklist
 
             // Allocate blockmap lump with computed count
             blockmaplump = malloc_IfSameLevel(blockmaplump, count * sizeof(*blockmaplump));
@@ -2429,35 +2440,62 @@ static void P_CreateBlockMap(void)
 
         // Now compress the blockmap.
         {
-            int     ndx = (tot += 4);   // Advance index to start of linedef lists
-            bmap_t  *bp = bmap;         // Start of uncompressed blockmap
+            int ndx = tot + 4;          // Advance index to start of linedef lists
+            int empty = ndx;
 
             blockmaplump[ndx++] = 0;    // Store an empty blockmap list at start
             blockmaplump[ndx++] = -1;   // (Used for compression)
 
-            for (unsigned int i = 4; i < tot; i++, bp++)
-                if (bp->n)                                          // Non-empty blocklist
+            for (unsigned int i = 0; i < tot; i++)
+                if (counts[i])                                      // Non-empty blocklist
                 {
-                    blockmaplump[(blockmaplump[i] = ndx++)] = 0;    // Store index and header
-
-                    do
-                        blockmaplump[ndx++] = bp->list[--bp->n];    // Copy linedef list
-                    while (bp->n);
+                    const int   n = counts[i];
 
+                    blockmaplump[(blockmaplump[i + 4] = ndx++)] = 0;    // Store index and header
+                    counts[i] = ndx;                                // Where the linedef list starts
+                    ndx += n;
                     blockmaplump[ndx++] = -1;                       // Store trailer
-                    free(bp->list);                                 // Free linedef list
                 }
                 else
                     // Empty blocklist: point to reserved empty blocklist
-                    blockmaplump[i] = tot;
+                    blockmaplump[i + 4] = empty;
+
+            // Copy the linedefs into their lists, last linedef first
+            for (int i = numlines - 1; i >= 0; i--)
+                for (int j = firstcell[i]; j < firstcell[i + 1]; j++)
+                    blockmaplump[counts[cells[j]]++] = i;
 
-            free(bmap); // Free uncompressed blockmap
+            free(cells);
+            free(firstcell);
+            free(counts);
         }
     }
 
     skipblstart = true;
 }
 
+static void *blockmapthread;
+
+static int P_CreateBlockMapThread(void *data)
+{
+    P_CreateBlockMap();
+    return 0;
+}
+
+//
+// P_StartCreatingBlockMap
+// Builds the blockmap in another thread while the nodes and segs are
+// loaded, except for ZDoom nodes, which may add to vertexes[] as they load.
+// P_FinishBlockMap() waits for it.
+//
+static void P_StartCreatingBlockMap(void)
+{
+    if (mapformat == ZDBSPX)
+        P_CreateBlockMap();
+    else
+        blockmapthread = I_CreateThread(&P_CreateBlockMapThread, NULL);
+}
+
 //
 // P_LoadBlockMap
 //
@@ -2476,12 +2514,12 @@ static void P_LoadBlockMap(int lump)
 
     if (lump >= numlumps || (lumplen = W_LumpLength(lump)) < 8 || (count = lumplen / 2) >= 0x10000)
     {
-        P_CreateBlockMap();
+        P_StartCreatingBlockMap();
         C_Warning(2, "The " BOLD("BLOCKMAP") " lump has been rebuilt.");
     }
     else if (M_CheckParm("-blockmap"))
     {
-        P_CreateBlockMap();
+        P_StartCreatingBlockMap();
         C_Warning(1, "A " BOLD("-blockmap") " parameter was found on the command-line. "
             "The " BOLD("BLOCKMAP") " lump has been rebuilt.");
     }
@@ -2516,10 +2554,16 @@ static void P_LoadBlockMap(int lump)
 
         if (!P_VerifyBlockMap(count))
         {
-            P_CreateBlockMap();
+            P_StartCreatingBlockMap();
             C_Warning(2, "The " BOLD("BLOCKMAP") " lump has been rebuilt.");
         }
     }
+}
+
+static void P_FinishBlockMap(void)
+{
+    I_WaitThread(blockmapthread);
+    blockmapthread = NULL;
 
     // Clear out mobj chains
     blocklinks = calloc_IfSameLevel(blocklinks, (size_t)bmapwidth * bmapheight, sizeof(*blocklinks));
@@ -2532,13 +2576,513 @@ static void P_LoadBlockMap(int lump)
     blockmapyneg = (bmapheight > 255 ? bmapheight - 512 : -257);
 }
 
+//
+// REJECT builder
+//
+// Most node builders leave the REJECT lump empty or zeroed, so every sight
+// check falls through to P_CrossBSPNode(). When that happens, a new table is
+// built by flooding out from each sector through its two-sided linedefs,
+// clipping each linedef to the part that can still be reached by a straight
+// line through those already crossed. A pair of sectors is only rejected
+// when no straight line can join them, so no sight check that would
+// otherwise succeed is ever rejected. The result is cached on disk.
+//
+#define REJECTEPSILON   1.0
+#define MAXREJECTDEPTH  1024
+#define MAXREJECTSTEPS  (1 << 18)
+
+typedef struct
+{
+    double  x1, y1;
+    double  x2, y2;
+} rejectwindow_t;
+
+typedef struct
+{
+    rejectwindow_t  window;         // the whole linedef
+    double          a, b, c;        // a * x + b * y + c > 0 on the side being entered
+    double          length;
+    int             line;
+    int             sector;         // the sector being entered
+} rejectportal_t;
+
+typedef struct
+{
+    const rejectportal_t    *source;
+    uint64_t                *visible;
+    double                  *hulls;         // part of each portal already flooded through
+    int                     *generations;
+    int                     generation;
+    int                     steps;
+    bool                    overflow;
+} rejectflood_t;
+
+static rejectportal_t   *rejectportals;
+static int              *firstrejectportal;
+static bool             *rejectunreliable;
+static uint64_t         *rejectvisible;
+static int              rejectrowwords;
+
+#define REJECTVISIBLE(row, sector)      ((row)[(sector) >> 6] & (1ull << ((sector) & 63)))
+#define SETREJECTVISIBLE(row, sector)   ((row)[(sector) >> 6] |= (1ull << ((sector) & 63)))
+
+static double P_RejectSide(const rejectportal_t *portal, const double x, const double y)
+{
+    return (portal->a * x + portal->b * y + portal->c);
+}
+
+//
+// P_ClipRejectWindow
+// Clips window to where a * x + b * y + c >= -REJECTEPSILON, and returns
+// false if nothing is left.
+//
+static bool P_ClipRejectWindow(rejectwindow_t *window, const double a, const double b, const double c)
+{
+    const double    d1 = a * window->x1 + b * window->y1 + c + REJECTEPSILON;
+    const double    d2 = a * window->x2 + b * window->y2 + c + REJECTEPSILON;
+
+    if (d1 < 0.0 && d2 < 0.0)
+        return false;
+
+    if (d1 < 0.0)
+    {
+        window->x1 += (window->x2 - window->x1) * d1 / (d1 - d2);
+        window->y1 += (window->y2 - window->y1) * d1 / (d1 - d2);
+    }
+    else if (d2 < 0.0)
+    {
+        window->x2 += (window->x1 - window->x2) * d2 / (d2 - d1);
+        window->y2 += (window->y1 - window->y2) * d2 / (d2 - d1);
+    }
+
+    return true;
+}
+
+//
+// P_ClipRejectSeparators
+// Clips window to the area that lines through both source and pass can
+// reach beyond pass. Each line joining an endpoint of source to an endpoint
+// of pass with the rest of source on one side and the rest of pass on the
+// other bounds that area.
+//
+static bool P_ClipRejectSeparators(rejectwindow_t *window, const rejectwindow_t *source,
+    const rejectwindow_t *pass)
+{
+    const double    sx[2] = { source->x1, source->x2 };
+    const double    sy[2] = { source->y1, source->y2 };
+    const double    px[2] = { pass->x1, pass->x2 };
+    const double    py[2] = { pass->y1, pass->y2 };
+
+    for (int i = 0; i < 2; i++)
+        for (int j = 0; j < 2; j++)
+        {
+            double          a = sy[i] - py[j];
+            double          b = px[j] - sx[i];
+            double          c;
+            double          ds, dp;
+            const double    length = sqrt(a * a + b * b);
+
+            if (length < REJECTEPSILON)
+                continue;
+
+            a /= length;
+            b /= length;
+            c = -(a * sx[i] + b * sy[i]);
+            ds = a * sx[i ^ 1] + b * sy[i ^ 1] + c;
+            dp = a * px[j ^ 1] + b * py[j ^ 1] + c;
+
+            if (ds <= 0.0 && dp >= 0.0 && (ds < 0.0 || dp > 0.0))
+            {
+                if (!P_ClipRejectWindow(window, a, b, c))
+                    return false;
+            }
+            else if (ds >= 0.0 && dp <= 0.0 && (ds > 0.0 || dp < 0.0))
+            {
+                if (!P_ClipRejectWindow(window, -a, -b, -c))
+                    return false;
+            }
+        }
+
+    return true;
+}
+
+static void P_FloodReject(rejectflood_t *flood, const rejectportal_t *pass, const rejectwindow_t *window,
+    const int depth)
+{
+    const rejectportal_t    *source = flood->source;
+
+    if (++flood->steps > MAXREJECTSTEPS || depth > MAXREJECTDEPTH)
+    {
+        flood->overflow = true;
+        return;
+    }
+
+    for (int i = firstrejectportal[pass->sector]; i < firstrejectportal[pass->sector + 1] && !flood->overflow; i++)
+    {
+        const rejectportal_t    *portal = &rejectportals[i];
+        rejectwindow_t          target = portal->window;
+        double                  *hull = &flood->hulls[i * 2];
+        double                  t1, t2;
+
+        if (portal->line == source->line || portal->line == pass->line)
+            continue;
+
+        // a straight line can only cross the portal into the sector beyond it
+        if ((P_RejectSide(portal, source->window.x1, source->window.y1) > REJECTEPSILON
+            && P_RejectSide(portal, source->window.x2, source->window.y2) > REJECTEPSILON)
+            || (P_RejectSide(portal, window->x1, window->y1) > REJECTEPSILON
+                && P_RejectSide(portal, window->x2, window->y2) > REJECTEPSILON))
+            continue;
+
+        // after crossing the source and the last portal
+        if (!P_ClipRejectWindow(&target, source->a, source->b, source->c)
+            || (pass != source && (!P_ClipRejectWindow(&target, pass->a, pass->b, pass->c)
+                || !P_ClipRejectSeparators(&target, &source->window, window))))
+            continue;
+
+        t1 = ((target.x1 - portal->window.x1) * (portal->window.x2 - portal->window.x1)
+            + (target.y1 - portal->window.y1) * (portal->window.y2 - portal->window.y1)) / portal->length;
+        t2 = ((target.x2 - portal->window.x1) * (portal->window.x2 - portal->window.x1)
+            + (target.y2 - portal->window.y1) * (portal->window.y2 - portal->window.y1)) / portal->length;
+
+        if (t1 > t2)
+        {
+            const double    temp = t1;
+
+            t1 = t2;
+            t2 = temp;
+        }
+
+        // Only flood through the part of the portal not already flooded
+        // through from the same source, widened so each pass grows it by at
+        // least REJECTEPSILON.
+        if (flood->generations[i] == flood->generation)
+        {
+            if (t1 >= hull[0] && t2 <= hull[1])
+                continue;
+
+            if (hull[0] < t1)
+                t1 = hull[0];
+
+            if (hull[1] > t2)
+                t2 = hull[1];
+        }
+
+        hull[0] = t1 = fmax(0.0, t1 - REJECTEPSILON);
+        hull[1] = t2 = fmin(portal->length, t2 + REJECTEPSILON);
+        flood->generations[i] = flood->generation;
+
+        target.x1 = portal->window.x1 + (portal->window.x2 - portal->window.x1) * t1 / portal->length;
+        target.y1 = portal->window.y1 + (portal->window.y2 - portal->window.y1) * t1 / portal->length;
+        target.x2 = portal->window.x1 + (portal->window.x2 - portal->window.x1) * t2 / portal->length;
+        target.y2 = portal->window.y1 + (portal->window.y2 - portal->window.y1) * t2 / portal->length;
+
+        SETREJECTVISIBLE(flood->visible, portal->sector);
+        P_FloodReject(flood, portal, &target, depth + 1);
+    }
+}
+
+//
+// P_FloodRejectConnected
+// Marks every sector that can be reached through two-sided linedefs as
+// visible. Used when flooding from a sector takes too long. The row is
+// cleared first, as sectors the abandoned flood had already marked would
+// otherwise stop the sectors beyond them from being reached.
+//
+static void P_FloodRejectConnected(uint64_t *visible, int *stack, const int sector)
+{
+    int count = 0;
+
+    memset(visible, 0, rejectrowwords * sizeof(*visible));
+    SETREJECTVISIBLE(visible, sector);
+    stack[count++] = sector;
+
+    while (count)
+    {
+        const int   s = stack[--count];
+
+        for (int i = firstrejectportal[s]; i < firstrejectportal[s + 1]; i++)
+        {
+            const int   next = rejectportals[i].sector;
+
+            if (!REJECTVISIBLE(visible, next))
+            {
+                SETREJECTVISIBLE(visible, next);
+                stack[count++] = next;
+            }
+        }
+    }
+}
+
+static void P_BuildRejectRange(int start, int end, int thread)
+{
+    const int       numportals = firstrejectportal[numsectors];
+    rejectflood_t   flood = { 0 };
+    int             *stack = malloc(((size_t)numsectors + 1) * sizeof(*stack));
+
+    flood.hulls = malloc(((size_t)numportals * 2 + 1) * sizeof(*flood.hulls));
+    flood.generations = calloc((size_t)numportals + 1, sizeof(*flood.generations));
+
+    for (int s = start; s < end; s++)
+    {
+        flood.visible = &rejectvisible[(size_t)s * rejectrowwords];
+        flood.steps = 0;
+        flood.overflow = false;
+
+        SETREJECTVISIBLE(flood.visible, s);
+
+        if (rejectunreliable[s])
+            continue;
+
+        for (int i = firstrejectportal[s]; i < firstrejectportal[s + 1] && !flood.overflow; i++)
+        {
+            flood.source = &rejectportals[i];
+            flood.generation++;
+            SETREJECTVISIBLE(flood.visible, flood.source->sector);
+            P_FloodReject(&flood, flood.source, &flood.source->window, 0);
+        }
+
+        if (flood.overflow)
+            P_FloodRejectConnected(flood.visible, stack, s);
+    }
+
+    free(flood.generations);
+    free(flood.hulls);
+    free(stack);
+}
+
+//
+// P_FindUnreliableRejectSectors
+// Sectors that aren't closed, have self-referencing linedefs or have
+// subsectors whose segs face other sectors don't match the area their
+// linedefs bound, so they are never rejected.
+//
+static void P_FindUnreliableRejectSectors(void)
+{
+    int *balance = calloc((size_t)numvertexes + 1, sizeof(*balance));
+
+    for (int i = 0; i < numlines; i++)
+        if ((lines[i].flags & ML_TWOSIDED) && lines[i].frontsector == lines[i].backsector)
+            rejectunreliable[lines[i].frontsector->id] = true;
+
+    for (int i = 0; i < numsubsectors; i++)
+    {
+        const sector_t  *sector = subsectors[i].sector;
+
+        for (int j = 0; j < subsectors[i].numlines; j++)
+        {
+            const seg_t *seg = &segs[subsectors[i].firstline + j];
+
+            if (seg->linedef && seg->frontsector && seg->frontsector != sector)
+            {
+                rejectunreliable[sector->id] = true;
+                rejectunreliable[seg->frontsector->id] = true;
+            }
+        }
+    }
+
+    // every vertex of a closed sector starts as many of its sides as it ends
+    for (int i = 0; i < numsectors; i++)
+    {
+        const sector_t  *sector = &sectors[i];
+
+        for (int j = 0; j < sector->linecount; j++)
+        {
+            const line_t    *line = sector->lines[j];
+
+            if (line->frontsector == sector)
+            {
+                balance[line->v1 - vertexes]++;
+                balance[line->v2 - vertexes]--;
+            }
+
+            if (line->backsector == sector)
+            {
+                balance[line->v2 - vertexes]++;
+                balance[line->v1 - vertexes]--;
+            }
+        }
+
+        for (int j = 0; j < sector->linecount; j++)
+        {
+            const line_t    *line = sector->lines[j];
+
+            if (balance[line->v1 - vertexes] || balance[line->v2 - vertexes])
+                rejectunreliable[i] = true;
+        }
+
+        for (int j = 0; j < sector->linecount; j++)
+        {
+            balance[sector->lines[j]->v1 - vertexes] = 0;
+            balance[sector->lines[j]->v2 - vertexes] = 0;
+        }
+    }
+
+    free(balance);
+}
+
+static void P_AddRejectPortal(int *count, const line_t *line, const sector_t *from, const sector_t *to,
+    const double sign)
+{
+    rejectportal_t  *portal = &rejectportals[count[from->id]++];
+    const double    dx = (double)line->dx / FRACUNIT;
+    const double    dy = (double)line->dy / FRACUNIT;
+
+    portal->window.x1 = (double)line->v1->x / FRACUNIT;
+    portal->window.y1 = (double)line->v1->y / FRACUNIT;
+    portal->window.x2 = (double)line->v2->x / FRACUNIT;
+    portal->window.y2 = (double)line->v2->y / FRACUNIT;
+    portal->length = sqrt(dx * dx + dy * dy);
+    portal->a = -dy * sign / portal->length;
+    portal->b = dx * sign / portal->length;
+    portal->c = -(portal->a * portal->window.x1 + portal->b * portal->window.y1);
+    portal->line = (int)(line - lines);
+    portal->sector = to->id;
+}
+
+static bool P_IsRejectPortal(const line_t *line)
+{
+    return ((line->flags & ML_TWOSIDED) && line->backsector && line->frontsector != line->backsector
+        && (line->dx || line->dy));
+}
+
+static uint64_t P_RejectHash(void)
+{
+    uint64_t    hash = 14695981039346656037ull;
+    int         data[8] = { 1, numsectors, numlines };
+
+    for (int i = -1; i < numlines + numsectors; i++)
+    {
+        if (i >= numlines)
+        {
+            data[0] = rejectunreliable[i - numlines];
+            data[1] = data[2] = data[3] = data[4] = data[5] = data[6] = data[7] = 0;
+        }
+        else if (i >= 0)
+        {
+            data[0] = lines[i].v1->x;
+            data[1] = lines[i].v1->y;
+            data[2] = lines[i].v2->x;
+            data[3] = lines[i].v2->y;
+            data[4] = (lines[i].flags & ML_TWOSIDED);
+            data[5] = (lines[i].frontsector ? lines[i].frontsector->id : -1);
+            data[6] = (lines[i].backsector ? lines[i].backsector->id : -1);
+        }
+
+        for (int j = 0; j < (int)sizeof(data); j++)
+            hash = (hash ^ ((byte *)data)[j]) * 1099511628211ull;
+    }
+
+    return hash;
+}
+
+static void P_BuildReject(byte *matrix, const size_t size)
+{
+    int         *count = calloc((size_t)numsectors + 1, sizeof(*count));
+    char        *appdatafolder = M_GetAppDataFolder();
+    char        rejectfolder[MAX_PATH];
+    char        filename[MAX_PATH];
+    uint64_t    hash;
+    FILE        *file;
+
+    rejectunreliable = calloc(numsectors, sizeof(*rejectunreliable));
+    P_FindUnreliableRejectSectors();
+
+    hash = P_RejectHash();
+    M_snprintf(rejectfolder, sizeof(rejectfolder), "%s" DIR_SEPARATOR_S DOOMRETRO_REJECTFOLDER, appdatafolder);
+    M_snprintf(filename, sizeof(filename), "%s" DIR_SEPARATOR_S "%08X%08X.reject",
+        rejectfolder, (unsigned int)(hash >> 32), (unsigned int)hash);
+    free(appdatafolder);
+
+    if ((file = fopen(filename, "rb")))
+    {
+        const bool  cached = (fread(matrix, 1, size, file) == size && fgetc(file) == EOF);
+
+        fclose(file);
+
+        if (cached)
+        {
+            free(rejectunreliable);
+            free(count);
+            return;
+        }
+
+        memset(matrix, 0, size);
+    }
+
+    // gather the two-sided linedefs leaving each sector
+    for (int i = 0; i < numlines; i++)
+        if (P_IsRejectPortal(&lines[i]))
+        {
+            count[lines[i].frontsector->id]++;
+            count[lines[i].backsector->id]++;
+        }
+
+    firstrejectportal = malloc(((size_t)numsectors + 1) * sizeof(*firstrejectportal));
+    firstrejectportal[0] = 0;
+
+    for (int i = 0; i < numsectors; i++)
+    {
+        firstrejectportal[i + 1] = firstrejectportal[i] + count[i];
+        count[i] = firstrejectportal[i];
+    }
+
+    rejectportals = malloc(((size_t)firstrejectportal[numsectors] + 1) * sizeof(*rejectportals));
+
+    for (int i = 0; i < numlines; i++)
+        if (P_IsRejectPortal(&lines[i]))
+        {
+            P_AddRejectPortal(count, &lines[i], lines[i].frontsector, lines[i].backsector, 1.0);
+            P_AddRejectPortal(count, &lines[i], lines[i].backsector, lines[i].frontsector, -1.0);
+        }
+
+    rejectrowwords = (numsectors + 63) / 64;
+    rejectvisible = calloc((size_t)numsectors * rejectrowwords, sizeof(*rejectvisible));
+
+    I_ParallelFor(&P_BuildRejectRange, numsectors, 16);
+
+    // a line of sight goes both ways, so reject any pair not seen both ways
+    for (int s1 = 0; s1 < numsectors; s1++)
+    {
+        const uint64_t  *row = &rejectvisible[(size_t)s1 * rejectrowwords];
+
+        if (rejectunreliable[s1])
+            continue;
+
+        for (int s2 = 0; s2 < numsectors; s2++)
+            if (!rejectunreliable[s2]
+                && (!REJECTVISIBLE(row, s2) || !REJECTVISIBLE(&rejectvisible[(size_t)s2 * rejectrowwords], s1)))
+            {
+                const size_t    pnum = (size_t)s1 * numsectors + s2;
+
+                matrix[pnum >> 3] |= (1 << (pnum & 7));
+            }
+    }
+
+    free(rejectvisible);
+    free(rejectportals);
+    free(firstrejectportal);
+    free(rejectunreliable);
+    free(count);
+
+    M_MakeDirectory(rejectfolder);
+
+    if ((file = fopen(filename, "wb")))
+    {
+        fwrite(matrix, 1, size, file);
+        fclose(file);
+    }
+}
+
 //
 // reject overrun emulation
+// If the lump is too short, it is copied into a new block and released,
+// and *lump is set to -1 so it isn't released again.
 //
-static void RejectOverrun(int lump, const byte **matrix)
+static void RejectOverrun(int *lump, const byte **matrix)
 {
     const size_t    required = ((size_t)numsectors * numsectors + 7) / 8;
-    const size_t    length = W_LumpLength(lump);
+    const size_t    length = W_LumpLength(*lump);
 
     if (length < required)
     {
@@ -2550,7 +3094,8 @@ static void RejectOverrun(int lump, const byte **matrix)
         memset(newreject + length, 0, required - length);
 
         // unlock the original lump, it is no longer needed
-        W_ReleaseLumpNum(lump);
+        W_ReleaseLumpNum(*lump);
+        *lump = -1;
 
         C_Warning(2, "The " BOLD("REJECT") " lump has been increased in size.");
     }
@@ -2569,7 +3114,36 @@ static void P_LoadReject(int lumpnum)
     rejectmatrix = W_CacheLumpNum(rejectlump);
 
     // e6y: check for overflow
-    RejectOverrun(rejectlump, &rejectmatrix);
+    RejectOverrun(&rejectlump, &rejectmatrix);
+
+    // build a new reject table if the map doesn't have one
+    if (numsectors)
+    {
+        const size_t    required = ((size_t)numsectors * numsectors + 7) / 8;
+        size_t          i = 0;
+
+        while (i < required && !rejectmatrix[i])
+            i++;
+
+        if (i == required)
+        {
+            byte    *matrix;
+
+            // RejectOverrun() has already copied a short lump into a zeroed block
+            if (rejectlump == -1)
+                matrix = (byte *)rejectmatrix;
+            else
+            {
+                matrix = Z_Calloc(1, required, PU_LEVEL, NULL);
+                W_ReleaseLumpNum(rejectlump);
+                rejectlump = -1;
+            }
+
+            P_BuildReject(matrix, required);
+            rejectmatrix = matrix;
+            C_Warning(2, "A new " BOLD("REJECT") " lump has been built.");
+        }
+    }
 }
 
 //
@@ -2597,7 +3171,9 @@ static void P_GroupLines(void)
     sector_t    *sector;
     int         i;
     int         total = numlines;
+    int         numsoundlinks = 0;
     line_t      **linebuffer;
+    soundlink_t *soundlinks;
 
     // figgi
     for (i = 0; i < numsubsectors; i++)
@@ -2658,6 +3234,43 @@ static void P_GroupLines(void)
             P_AddLineToSector(li, li->backsector);
     }
 
+    // link each sector to the sectors sound can travel to from it
+    for (i = 0, sector = sectors; i < numsectors; i++, sector++)
+        for (int j = 0; j < sector->linecount; j++)
+        {
+            li = sector->lines[j];
+
+            if ((li->flags & ML_TWOSIDED) && li->sidenum[1] != NO_INDEX)
+                numsoundlinks++;
+        }
+
+    soundlinks = Z_Malloc(MAX(1, numsoundlinks) * sizeof(*soundlinks), PU_LEVEL, NULL);
+    soundqueue = Z_Malloc(MAX(1, numsectors) * sizeof(*soundqueue), PU_LEVEL, NULL);
+
+    for (i = 0, sector = sectors; i < numsectors; i++, sector++)
+    {
+        sector->soundlinks = soundlinks;
+        sector->numsoundlinks = 0;
+
+        for (int j = 0; j < sector->linecount; j++)
+        {
+            li = sector->lines[j];
+
+            if ((li->flags & ML_TWOSIDED) && li->sidenum[1] != NO_INDEX)
+            {
+                soundlink_t *link = &sector->soundlinks[sector->numsoundlinks++];
+
+                link->sector = sides[li->sidenum[sides[li->sidenum[0]].sector == sector]].sector;
+                link->line = li;
+                link->soundblock = (li->flags & ML_SOUNDBLOCK);
+                link->open = false;
+                link->checkedtime = INT_MIN;
+            }
+        }
+
+        soundlinks += sector->numsoundlinks;
+    }
+
     for (i = 0, sector = sectors; i < numsectors; i++, sector++)
     {
         fixed_t *bbox = (void *)sector->blockbox;
@@ -2771,9 +3384,9 @@ static void P_RemoveSlimeTrails(void)                   // killough 10/98
 }
 
 // Precalculate values for use later in long wall error fix in R_StoreWallRange()
-static void P_CalcSegsLength(void)
+static void P_CalcSegsLengthRange(int start, int end, int thread)
 {
-    for (int i = 0; i < numsegs; i++)
+    for (int i = start; i < end; i++)
     {
         seg_t   *li = segs + i;
 
@@ -2795,6 +3408,12 @@ static void P_CalcSegsLength(void)
     }
 }
 
+static void P_CalcSegsLength(void)
+{
+    // each seg is independent of the others, so split them across all cores
+    I_ParallelFor(&P_CalcSegsLengthRange, numsegs, 4096);
+}
+
 char    mapnum[6];
 char    maptitle[256];
 char    mapnumandtitle[512];
@@ -3021,6 +3640,47 @@ static mapformat_t P_CheckMapFormat(int lumpnum)
 //
 // P_SetupLevel
 //
+//
+// Load-time breakdown, shown in the console with -devparm
+//
+#define MAXLOADTIMES    16
+
+static struct
+{
+    const char  *name;
+    uint64_t    time;
+} loadtimes[MAXLOADTIMES];
+
+static int      numloadtimes;
+static uint64_t loadtime;
+
+static void P_AddLoadTime(const char *name)
+{
+    const uint64_t  now = I_GetTimeUS();
+
+    if (numloadtimes < MAXLOADTIMES)
+    {
+        loadtimes[numloadtimes].name = name;
+        loadtimes[numloadtimes++].time = now - loadtime;
+    }
+
+    loadtime = now;
+}
+
+static void P_ShowLoadTimes(void)
+{
+    const int   tabs[3] = { 280, 0, 0 };
+    uint64_t    total = 0;
+
+    for (int i = 0; i < numloadtimes; i++)
+    {
+        C_TabbedOutput(tabs, "%s\t%.2fms", loadtimes[i].name, loadtimes[i].time / 1000.0);
+        total += loadtimes[i].time;
+    }
+
+    C_TabbedOutput(tabs, "Total\t" BOLD("%.2fms"), total / 1000.0);
+}
+
 void P_SetupLevel(int ep, int map)
 {
     char        lumpname[6];
@@ -3050,6 +3710,14 @@ void P_SetupLevel(int ep, int map)
     idclev = false;
     idclevtics = 0;
 
+    sightcacheepoch++;
+    numdormantmobjs = 0;
+    dormantplayersector = NULL;
+
+    // show the memory used by the previous map before it is freed
+    if (zoneaccounting)
+        C_MemStats();
+
     Z_FreeTags(PU_LEVEL, PU_PURGELEVEL - 1);
 
     if (rejectlump != -1)
@@ -3090,14 +3758,14 @@ void P_SetupLevel(int ep, int map)
     }
 
     if ((!numconsolestrings
-        || (!M_StringStartsWith(console[numconsolestrings - 1].string, "map ")
-            && !M_StringStartsWith(console[numconsolestrings - 1].string, "load ")
-            && !M_StringStartsWith(console[numconsolestrings - 1].string, "newgame")
-            && !M_StringStartsWith(console[numconsolestrings - 1].string, "Warping ")
-            && !M_StringCompare(console[numconsolestrings - 1].string, "restartmap")
+        || (!M_StringStartsWith(C_ConsoleLine(numconsolestrings - 1)->string, "map ")
+            && !M_StringStartsWith(C_ConsoleLine(numconsolestrings - 1)->string, "load ")
+            && !M_StringStartsWith(C_ConsoleLine(numconsolestrings - 1)->string, "newgame")
+            && !M_StringStartsWith(C_ConsoleLine(numconsolestrings - 1)->string, "Warping ")
+            && !M_StringCompare(C_ConsoleLine(numconsolestrings - 1)->string, "restartmap")
             && !autostart))
         && ((numconsolestrings == 1
-            || (!M_StringStartsWith(console[numconsolestrings - 2].string, "map ")
+            || (!M_StringStartsWith(C_ConsoleLine(numconsolestrings - 2)->string, "map ")
                 && !autostart))))
         C_Input("map %s", lumpname);
 
@@ -3156,6 +3824,10 @@ void P_SetupLevel(int ep, int map)
         free(segs);
         free(nodes);
         free(subsectors);
+
+        for (int i = 0; i < bmapwidth * bmapheight; i++)
+            free(blocklinks[i].things);
+
         free(blocklinks);
         free(blockmaplump);
         free(lines);
@@ -3164,6 +3836,9 @@ void P_SetupLevel(int ep, int map)
         free(vertexes);
     }
 
+    numloadtimes = 0;
+    loadtime = I_GetTimeUS();
+
     // note: most of this ordering is important
     P_LoadVertexes(lumpnum + ML_VERTEXES);
     P_LoadSectors(lumpnum + ML_SECTORS);
@@ -3175,11 +3850,11 @@ void P_SetupLevel(int ep, int map)
     P_InitTagLists();
 
     P_LoadLineDefs2();
+    P_AddLoadTime("Vertexes, sectors, sidedefs and linedefs");
 
+    // the blockmap may be built in another thread while the nodes are loaded
     if (!samelevel)
         P_LoadBlockMap(lumpnum + ML_BLOCKMAP);
-    else
-        memset(blocklinks, 0, (size_t)bmapwidth * bmapheight * sizeof(*blocklinks));
 
     if (mapformat == ZDBSPX)
         P_LoadZNodes(lumpnum + ML_NODES);
@@ -3196,12 +3871,23 @@ void P_SetupLevel(int ep, int map)
         P_LoadSegs(lumpnum + ML_SEGS);
     }
 
+    if (!samelevel)
+        P_FinishBlockMap();
+    else
+        for (int i = 0; i < bmapwidth * bmapheight; i++)
+            blocklinks[i].numthings = 0;
+
+    P_AddLoadTime("Blockmap, nodes, subsectors and segs");
+
     P_GroupLines();
+    P_AddLoadTime("Grouping linedefs");
+
     P_LoadReject(lumpnum);
+    P_AddLoadTime("Reject");
 
     P_RemoveSlimeTrails();
-
     P_CalcSegsLength();
+    P_AddLoadTime("Slime trails and seg lengths");
 
     markpointnum = 0;
     markpointnum_max = 0;
@@ -3220,6 +3906,7 @@ void P_SetupLevel(int ep, int map)
     P_SetLiquids();
 
     P_LoadThings(map, lumpnum + ML_THINGS);
+    P_AddLoadTime("Things");
 
     numfriends = 0;
 
@@ -3232,9 +3919,14 @@ void P_SetupLevel(int ep, int map)
     P_SetLifts();
 
     P_MapEnd();
+    P_AddLoadTime("Specials");
 
     // preload graphics
     R_PrecacheLevel();
+    P_AddLoadTime("Precaching graphics");
+
+    if (devparm)
+        P_ShowLoadTimes();
 
     S_Start();
 
@@ -33,8 +33,11 @@
 ==============================================================================
 */
 
+#include "doomstat.h"
+#include "i_system.h"
 #include "m_bbox.h"
 #include "p_local.h"
+#include "z_zone.h"
 
 //
 // P_CheckSight
@@ -52,9 +55,44 @@ typedef struct
     fixed_t     bbox[4];
     fixed_t     maxz;           // cph - z optimizations for 2-sided lines
     fixed_t     minz;
+    int         *validcounts;   // when each linedef was last checked
+    int         validcount;
 } los_t;
 
-static los_t    los;            // cph - made static
+// cph - made static
+// one for each thread, so that lines of sight can be checked in parallel
+static los_t    threadlos[MAXTHREADS];
+
+//
+// Sight cache
+// Results of P_CheckSight() are kept for the rest of the tic, keyed on both
+// mobjs and where they are, so moving either of them misses the cache.
+// Moving any floor or ceiling increments sightcacheepoch, emptying it.
+//
+#define SIGHTCACHESIZE  4096
+
+typedef struct
+{
+    mobj_t      *t1;
+    mobj_t      *t2;
+    fixed_t     x1, y1, z1;
+    fixed_t     x2, y2, z2;
+    fixed_t     height1;
+    fixed_t     height2;
+    int         tic;
+    int         epoch;
+    bool        result;
+} sightcache_t;
+
+static sightcache_t sightcache[SIGHTCACHESIZE];
+
+int             sightcacheepoch;
+int             sightcachehits;         // hits and misses during the last tic
+int             sightcachemisses;
+
+static int      sightcachetic;
+static int      tichits;
+static int      ticmisses;
 
 //
 // P_DivlineSide
@@ -79,7 +117,7 @@ static int P_DivlineSide(const fixed_t x, const fixed_t y, const divline_t *node
 // P_CrossSubsector
 // Returns true if strace crosses the given subsector successfully.
 //
-static bool P_CrossSubsector(const int num)
+static bool P_CrossSubsector(const int num, los_t *los)
 {
     subsector_t *sub = subsectors + num;
     seg_t       *seg = segs + sub->firstline;
@@ -96,12 +134,12 @@ static bool P_CrossSubsector(const int num)
         vertex_t    *v1;
         vertex_t    *v2;
 
-        if (line->bbox[BOXLEFT] > los.bbox[BOXRIGHT]
-            || line->bbox[BOXRIGHT] < los.bbox[BOXLEFT]
-            || line->bbox[BOXBOTTOM] > los.bbox[BOXTOP]
-            || line->bbox[BOXTOP] < los.bbox[BOXBOTTOM])
+        if (line->bbox[BOXLEFT] > los->bbox[BOXRIGHT]
+            || line->bbox[BOXRIGHT] < los->bbox[BOXLEFT]
+            || line->bbox[BOXBOTTOM] > los->bbox[BOXTOP]
+            || line->bbox[BOXTOP] < los->bbox[BOXBOTTOM])
         {
-            line->validcount = validcount;
+            los->validcounts[line->id] = los->validcount;
             continue;
         }
 
@@ -109,9 +147,9 @@ static bool P_CrossSubsector(const int num)
         v2 = line->v2;
 
         // line isn't crossed?
-        if (P_DivlineSide(v1->x, v1->y, &los.strace) == P_DivlineSide(v2->x, v2->y, &los.strace))
+        if (P_DivlineSide(v1->x, v1->y, &los->strace) == P_DivlineSide(v2->x, v2->y, &los->strace))
         {
-            line->validcount = validcount;
+            los->validcounts[line->id] = los->validcount;
             continue;
         }
 
@@ -121,17 +159,17 @@ static bool P_CrossSubsector(const int num)
         divl.dy = line->dy;
 
         // line isn't crossed?
-        if (P_DivlineSide(los.strace.x, los.strace.y, &divl) == P_DivlineSide(los.t2x, los.t2y, &divl))
+        if (P_DivlineSide(los->strace.x, los->strace.y, &divl) == P_DivlineSide(los->t2x, los->t2y, &divl))
         {
-            line->validcount = validcount;
+            los->validcounts[line->id] = los->validcount;
             continue;
         }
 
         // already checked other side?
-        if (line->validcount == validcount)
+        if (los->validcounts[line->id] == los->validcount)
             continue;
 
-        line->validcount = validcount;
+        los->validcounts[line->id] = los->validcount;
 
         // stop because it is not two sided anyway
         if (!(line->flags & ML_TWOSIDED))
@@ -154,23 +192,23 @@ static bool P_CrossSubsector(const int num)
         bottom = MAX(front->floorheight, back->floorheight);
 
         // cph - reject if does not intrude in the z-space of the possible LOS
-        if (top >= los.maxz && bottom <= los.minz)
+        if (top >= los->maxz && bottom <= los->minz)
             continue;
 
         // cph - if bottom >= top or top < minz or bottom > maxz then it must be solid wrt this LOS
-        if (bottom >= top || top < los.minz || bottom > los.maxz)
+        if (bottom >= top || top < los->minz || bottom > los->maxz)
             return false;
 
         // crosses a two sided line
-        frac = P_InterceptVector(&los.strace, &divl);
+        frac = P_InterceptVector(&los->strace, &divl);
 
         if (front->floorheight != back->floorheight)
-            los.bottomslope = MAX(los.bottomslope, FixedDiv(bottom - los.sightzstart, frac));
+            los->bottomslope = MAX(los->bottomslope, FixedDiv(bottom - los->sightzstart, frac));
 
         if (front->ceilingheight != back->ceilingheight)
-            los.topslope = MIN(los.topslope, FixedDiv(top - los.sightzstart, frac));
+            los->topslope = MIN(los->topslope, FixedDiv(top - los->sightzstart, frac));
 
-        if (los.topslope <= los.bottomslope)
+        if (los->topslope <= los->bottomslope)
             return false;   // stop
     }
 
@@ -182,30 +220,30 @@ static bool P_CrossSubsector(const int num)
 // P_CrossBSPNode
 // Returns true if strace crosses the given node successfully.
 //
-static bool P_CrossBSPNode(int bspnum)
+static bool P_CrossBSPNode(int bspnum, los_t *los)
 {
     while (!(bspnum & NF_SUBSECTOR))
     {
         const node_t    *bsp = nodes + bspnum;
-        const int       side1 = R_PointOnSide(los.strace.x, los.strace.y, bsp);
-        const int       side2 = R_PointOnSide(los.t2x, los.t2y, bsp);
+        const int       side1 = R_PointOnSide(los->strace.x, los->strace.y, bsp);
+        const int       side2 = R_PointOnSide(los->t2x, los->t2y, bsp);
 
         if (side1 == side2)
-            bspnum = bsp->children[side1];              // doesn't touch the other side
-        else if (!P_CrossBSPNode(bsp->children[side1])) // the partition plane is crossed here
-            return false;                               // cross the starting side
+            bspnum = bsp->children[side1];                  // doesn't touch the other side
+        else if (!P_CrossBSPNode(bsp->children[side1], los))    // the partition plane is crossed here
+            return false;                                   // cross the starting side
         else
-            bspnum = bsp->children[side1 ^ 1];          // cross the ending side
+            bspnum = bsp->children[side1 ^ 1];              // cross the ending side
     }
 
-    return P_CrossSubsector(bspnum == -1 ? 0 : (bspnum & ~NF_SUBSECTOR));
+    return P_CrossSubsector(bspnum == -1 ? 0 : (bspnum & ~NF_SUBSECTOR), los);
 }
 
 //
 // P_CheckSight
 // Returns true if a straight line between t1 and t2 is unobstructed. Uses REJECT.
 //
-bool P_CheckSight(mobj_t *t1, mobj_t *t2)
+static bool P_CheckSightUncached(mobj_t *t1, mobj_t *t2, los_t *los)
 {
     const sector_t  *s1 = t1->subsector->sector;
     const sector_t  *s2 = t2->subsector->sector;
@@ -237,43 +275,141 @@ bool P_CheckSight(mobj_t *t1, mobj_t *t2)
 
     // An unobstructed LOS is possible.
     // Now look from eyes of t1 to any part of t2.
-    validcount++;
+    los->validcount++;
 
-    los.sightzstart = t1->z + t1->height - (t1->height >> 2);
-    los.bottomslope = t2->z - los.sightzstart;
-    los.topslope = los.bottomslope + t2->height;
+    los->sightzstart = t1->z + t1->height - (t1->height >> 2);
+    los->bottomslope = t2->z - los->sightzstart;
+    los->topslope = los->bottomslope + t2->height;
 
-    los.strace.x = t1->x;
-    los.strace.y = t1->y;
-    los.t2x = t2->x;
-    los.t2y = t2->y;
-    los.strace.dx = t2->x - t1->x;
-    los.strace.dy = t2->y - t1->y;
+    los->strace.x = t1->x;
+    los->strace.y = t1->y;
+    los->t2x = t2->x;
+    los->t2y = t2->y;
+    los->strace.dx = t2->x - t1->x;
+    los->strace.dy = t2->y - t1->y;
 
-    los.bbox[BOXRIGHT] = MAX(t1->x, t2->x);
-    los.bbox[BOXLEFT] = MIN(t1->x, t2->x);
-    los.bbox[BOXTOP] = MAX(t1->y, t2->y);
-    los.bbox[BOXBOTTOM] = MIN(t1->y, t2->y);
+    los->bbox[BOXRIGHT] = MAX(t1->x, t2->x);
+    los->bbox[BOXLEFT] = MIN(t1->x, t2->x);
+    los->bbox[BOXTOP] = MAX(t1->y, t2->y);
+    los->bbox[BOXBOTTOM] = MIN(t1->y, t2->y);
 
     // cph - calculate min and max z of the potential line of sight
-    if (los.sightzstart < t2->z)
+    if (los->sightzstart < t2->z)
     {
-        los.maxz = t2->z + t2->height;
-        los.minz = los.sightzstart;
+        los->maxz = t2->z + t2->height;
+        los->minz = los->sightzstart;
     }
-    else if (los.sightzstart > t2->z + t2->height)
+    else if (los->sightzstart > t2->z + t2->height)
     {
-        los.maxz = los.sightzstart;
-        los.minz = t2->z;
+        los->maxz = los->sightzstart;
+        los->minz = t2->z;
     }
     else
     {
-        los.maxz = t2->z + t2->height;
-        los.minz = t2->z;
+        los->maxz = t2->z + t2->height;
+        los->minz = t2->z;
     }
 
     // the head node is the last node output
-    return P_CrossBSPNode(numnodes - 1);
+    return P_CrossBSPNode(numnodes - 1, los);
+}
+
+static sightcache_t *P_SightCacheEntry(const mobj_t *t1, const mobj_t *t2)
+{
+    return &sightcache[((uintptr_t)t1 / sizeof(mobj_t) * 31 + (uintptr_t)t2 / sizeof(mobj_t))
+        & (SIGHTCACHESIZE - 1)];
+}
+
+static bool P_StoreSight(sightcache_t *cache, mobj_t *t1, mobj_t *t2, const bool result)
+{
+    cache->t1 = t1;
+    cache->t2 = t2;
+    cache->x1 = t1->x;
+    cache->y1 = t1->y;
+    cache->z1 = t1->z;
+    cache->height1 = t1->height;
+    cache->x2 = t2->x;
+    cache->y2 = t2->y;
+    cache->z2 = t2->z;
+    cache->height2 = t2->height;
+    cache->tic = gametime;
+    cache->epoch = sightcacheepoch;
+
+    return (cache->result = result);
+}
+
+// zone memory can't be allocated from other threads, so this is done first
+static void P_InitSightThread(los_t *los)
+{
+    if (!los->validcounts)
+    {
+        los->validcounts = Z_Calloc(numlines, sizeof(int), PU_LEVEL, (void **)&los->validcounts);
+        los->validcount = 0;
+    }
+}
+
+bool P_CheckSight(mobj_t *t1, mobj_t *t2)
+{
+    sightcache_t    *cache = P_SightCacheEntry(t1, t2);
+
+    if (sightcachetic != gametime)
+    {
+        sightcachehits = tichits;
+        sightcachemisses = ticmisses;
+        tichits = 0;
+        ticmisses = 0;
+        sightcachetic = gametime;
+    }
+
+    if (cache->t1 == t1 && cache->t2 == t2
+        && cache->tic == gametime && cache->epoch == sightcacheepoch
+        && cache->x1 == t1->x && cache->y1 == t1->y && cache->z1 == t1->z && cache->height1 == t1->height
+        && cache->x2 == t2->x && cache->y2 == t2->y && cache->z2 == t2->z && cache->height2 == t2->height)
+    {
+        tichits++;
+        return cache->result;
+    }
+
+    ticmisses++;
+    P_InitSightThread(&threadlos[0]);
+
+    return P_StoreSight(cache, t1, t2, P_CheckSightUncached(t1, t2, &threadlos[0]));
+}
+
+//
+// P_CheckSights
+// Checks the lines of sight from each of lookers to the same element of
+// targets in parallel, and leaves the results in the sight cache. Later
+// calls to P_CheckSight() this tic for the same pairs will use them, as
+// long as neither mobj has moved and no floors or ceilings have.
+//
+static mobj_t   **sightlookers;
+static mobj_t   **sighttargets;
+static bool     *sightresults;
+
+static void P_CheckSightsRange(int start, int end, int thread)
+{
+    for (int i = start; i < end; i++)
+        sightresults[i] = P_CheckSightUncached(sightlookers[i], sighttargets[i], &threadlos[thread]);
+}
+
+void P_CheckSights(mobj_t **lookers, mobj_t **targets, int count)
+{
+    static int  maxcount;
+
+    if (count > maxcount)
+        sightresults = I_Realloc(sightresults, (maxcount = count) * sizeof(*sightresults));
+
+    for (int i = 0; i < MAXTHREADS; i++)
+        P_InitSightThread(&threadlos[i]);
+
+    sightlookers = lookers;
+    sighttargets = targets;
+    I_ParallelFor(&P_CheckSightsRange, count, 64);
+
+    // store the results in order, so the cache is the same however many threads are used
+    for (int i = 0; i < count; i++)
+        P_StoreSight(P_SightCacheEntry(lookers[i], targets[i]), lookers[i], targets[i], sightresults[i]);
 }
 
 //
@@ -74,6 +74,8 @@ typedef struct
     int     basepic;
     int     numpics;
     int     speed;
+    int     nexttic;        // animatedtic when the frame next changes
+    bool    overlapped;     // shares pics with an earlier animation
 } anim_t;
 
 #if defined(_MSC_VER) || defined(__GNUC__)
@@ -306,6 +308,20 @@ void P_InitPicAnims(void)
         if (!lastanim->speed)
             lastanim->speed = 1;
 
+        lastanim->nexttic = 0;
+        lastanim->overlapped = false;
+
+        // an animation sharing pics with an earlier one must be updated on
+        // every tic, so it always overrides it as it did before
+        for (anim_t *anim = anims; anim < lastanim; anim++)
+            if (anim->istexture == lastanim->istexture
+                && anim->basepic < lastanim->basepic + lastanim->numpics
+                && lastanim->basepic < anim->basepic + anim->numpics)
+            {
+                lastanim->overlapped = true;
+                break;
+            }
+
         lastanim++;
     }
 
@@ -966,7 +982,7 @@ bool P_CanUnlockGenDoor(line_t *line)
                     (M_StringCompare(playername, playername_default) ? "" : "s"),
                     s_PD_KEYCARDORSKULLKEY);
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return false;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -990,7 +1006,7 @@ bool P_CanUnlockGenDoor(line_t *line)
                     (M_StringCompare(playername, playername_default) ? "" : "s"),
                     (viewplayer->cards[it_redskull] == CARDNOTFOUNDYET ? s_PD_KEYCARDORSKULLKEY : s_PD_KEYCARD));
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return false;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -1014,7 +1030,7 @@ bool P_CanUnlockGenDoor(line_t *line)
                     (M_StringCompare(playername, playername_default) ? "" : "s"),
                     (viewplayer->cards[it_blueskull] == CARDNOTFOUNDYET ? s_PD_KEYCARDORSKULLKEY : s_PD_KEYCARD));
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return false;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -1038,7 +1054,7 @@ bool P_CanUnlockGenDoor(line_t *line)
                     (M_StringCompare(playername, playername_default) ? "" : "s"),
                     (viewplayer->cards[it_yellowskull] == CARDNOTFOUNDYET ? s_PD_KEYCARDORSKULLKEY : s_PD_KEYCARD));
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return false;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -1062,7 +1078,7 @@ bool P_CanUnlockGenDoor(line_t *line)
                     (M_StringCompare(playername, playername_default) ? "" : "s"),
                     (viewplayer->cards[it_redcard] == CARDNOTFOUNDYET ? s_PD_KEYCARDORSKULLKEY : s_PD_SKULLKEY));
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return false;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -1086,7 +1102,7 @@ bool P_CanUnlockGenDoor(line_t *line)
                     (M_StringCompare(playername, playername_default) ? "" : "s"),
                     (viewplayer->cards[it_bluecard] == CARDNOTFOUNDYET ? s_PD_KEYCARDORSKULLKEY : s_PD_SKULLKEY));
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return false;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -1110,7 +1126,7 @@ bool P_CanUnlockGenDoor(line_t *line)
                     (M_StringCompare(playername, playername_default) ? "" : "s"),
                     (viewplayer->cards[it_yellowcard] == CARDNOTFOUNDYET ? s_PD_KEYCARDORSKULLKEY : s_PD_SKULLKEY));
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return false;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -1135,7 +1151,7 @@ bool P_CanUnlockGenDoor(line_t *line)
                 M_snprintf(buffer, sizeof(buffer), s_PD_ALL6, playername,
                     (M_StringCompare(playername, playername_default) ? "" : "s"));
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return false;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -1157,7 +1173,7 @@ bool P_CanUnlockGenDoor(line_t *line)
                 M_snprintf(buffer, sizeof(buffer), s_PD_ALL3, playername,
                     (M_StringCompare(playername, playername_default) ? "" : "s"));
 
-                if (autousing && M_StringCompare(buffer, console[numconsolestrings - 1].string))
+                if (autousing && M_StringCompare(buffer, C_ConsoleLine(numconsolestrings - 1)->string))
                     return false;
 
                 HU_PlayerMessage(buffer, false, false);
@@ -2350,17 +2366,31 @@ void P_PlayerInSpecialSector(sector_t *sector)
 //
 void P_UpdateSpecials(void)
 {
+    int numactive;
+
     // ANIMATE FLATS AND TEXTURES GLOBALLY
+    // Only on the tics their frames change, or after animatedtic is reset.
     for (anim_t *anim = anims; anim < lastanim; anim++)
+    {
+        const int   speed = anim->speed;
+        int         frame;
+
+        if (animatedtic < anim->nexttic && animatedtic >= anim->nexttic - speed && !anim->overlapped)
+            continue;
+
+        frame = animatedtic / speed;
+        anim->nexttic = (frame + 1) * speed;
+
         for (int i = 0; i < anim->numpics; i++)
         {
-            const int   pic = anim->basepic + (animatedtic / anim->speed + i) % anim->numpics;
+            const int   pic = anim->basepic + (frame + i) % anim->numpics;
 
             if (anim->istexture)
                 texturetranslation[anim->basepic + i] = pic;
             else
                 flattranslation[anim->basepic + i] = firstflat + pic;
         }
+    }
 
     if (menuactive && (gametime & 2))
         return;
@@ -2382,18 +2412,27 @@ void P_UpdateSpecials(void)
         G_ExitLevel();
 
     // DO BUTTONS
-    for (int i = 0; i < maxbuttons; i++)
-        if (buttonlist[i].btimer && !--buttonlist[i].btimer)
+    // Active buttons are kept together at the start of buttonlist, in the
+    // order they were pressed.
+    numactive = 0;
+
+    for (int i = 0; i < numbuttons; i++)
+    {
+        button_t    *button = &buttonlist[i];
+
+        if (--button->btimer)
+            buttonlist[numactive++] = *button;
+        else
         {
-            line_t      *line = buttonlist[i].line;
+            line_t      *line = button->line;
             sector_t    *sector = line->backsector;
             const int   sidenum = line->sidenum[0];
             const short toptexture = sides[sidenum].toptexture;
             const short midtexture = sides[sidenum].midtexture;
             const short bottomtexture = sides[sidenum].bottomtexture;
-            const int   btexture = buttonlist[i].btexture;
+            const int   btexture = button->btexture;
 
-            switch (buttonlist[i].bwhere)
+            switch (button->bwhere)
             {
                 case top:
                     sides[sidenum].toptexture = btexture;
@@ -2433,8 +2472,11 @@ void P_UpdateSpecials(void)
             }
 
             if (!sector || (!sector->floordata && !sector->ceilingdata) || line->tag != sector->tag)
-                S_StartSectorSound(buttonlist[i].soundorg, sfx_swtchn);
+                S_StartSectorSound(button->soundorg, sfx_swtchn);
         }
+    }
+
+    numbuttons = numactive;
 }
 
 //
@@ -2471,7 +2513,7 @@ bool EV_DoDonut(line_t *line)
             rtn = true;
 
             // Spawn rising slime
-            floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+            floor = Z_SlabCalloc(&floorslab);
 
             floor->thinker.function = &T_MoveFloor;
             P_AddThinker(&floor->thinker);
@@ -2486,7 +2528,7 @@ bool EV_DoDonut(line_t *line)
             floor->stopsound = (s2->floorheight != floor->floordestheight);
 
             // Spawn lowering donut-hole
-            floor = Z_Calloc(1, sizeof(*floor), PU_LEVSPEC, NULL);
+            floor = Z_SlabCalloc(&floorslab);
 
             floor->thinker.function = &T_MoveFloor;
             P_AddThinker(&floor->thinker);
@@ -2609,8 +2651,7 @@ void P_SpawnSpecials(void)
     P_RemoveAllActiveCeilings();        // jff 02/22/98 use killough's scheme
     P_RemoveAllActivePlats();           // killough
 
-    for (int i = 0; i < maxbuttons; i++)
-        memset(&buttonlist[i], 0, sizeof(button_t));
+    numbuttons = 0;
 
     P_SpawnScrollers();                 // killough 03/07/98: Add generalized scrollers
     P_SpawnFriction();                  // phares 03/12/98: New friction model using linedefs
@@ -2685,106 +2726,249 @@ void P_SpawnSpecials(void)
 //
 // This is the main scrolling code
 // killough 03/07/98
-void T_Scroll(scroll_t *scroller)
+scrollerlist_t  sidescrollers;
+scrollerlist_t  floorscrollers;
+scrollerlist_t  ceilingscrollers;
+
+scrollcontrol_t *scrollcontrols;
+
+static int      *scrollcontrolsectors;
+static int      numscrollcontrolsectors;
+static int      maxscrollcontrolsectors;
+
+// Works out how far a scroller moves this tic, given how far the combined
+// height of its control sector has changed since last tic.
+static bool P_ScrollAmount(scroll_t *scroller, const fixed_t delta, fixed_t *dx, fixed_t *dy)
 {
-    fixed_t dx = scroller->dx;
-    fixed_t dy = scroller->dy;
+    *dx = scroller->dx;
+    *dy = scroller->dy;
 
-    // [BH] only allow wall scrollers to update once per tic
-    if (scroller->type == sc_side)
+    if (scroller->control != -1)
     {
-        static int  prevaffectee = -1;
-        static int  prevtime = -1;
-
-        if (prevaffectee == scroller->affectee && prevtime == gametime)
-            return;
+        // compute scroll amounts based on a sector's height changes
+        *dx = FixedMul(*dx, delta);
+        *dy = FixedMul(*dy, delta);
+    }
 
-        prevaffectee = scroller->affectee;
-        prevtime = gametime;
+    // killough 03/14/98: Add acceleration
+    if (scroller->accel)
+    {
+        scroller->vdx = (*dx += scroller->vdx);
+        scroller->vdy = (*dy += scroller->vdy);
     }
 
+    return (*dx | *dy);                 // no-op if both (x,y) offsets 0
+}
+
+//
+// T_Scroll
+//
+// Only carriers are still thinkers, as they move the things in a sector
+// rather than an offset. Wall, floor and ceiling scrollers are moved by
+// P_RunScrollers().
+//
+void T_Scroll(scroll_t *scroller)
+{
+    fixed_t delta = 0;
+    fixed_t dx, dy;
+
     if (scroller->control != -1)
     {
-        // compute scroll amounts based on a sector's height changes
         const fixed_t   height = sectors[scroller->control].floorheight + sectors[scroller->control].ceilingheight;
-        const fixed_t   delta = height - scroller->lastheight;
 
+        delta = height - scroller->lastheight;
         scroller->lastheight = height;
-        dx = FixedMul(dx, delta);
-        dy = FixedMul(dy, delta);
     }
 
-    // killough 03/14/98: Add acceleration
-    if (scroller->accel)
+    if (P_ScrollAmount(scroller, delta, &dx, &dy))
     {
-        scroller->vdx = (dx += scroller->vdx);
-        scroller->vdy = (dy += scroller->vdy);
+        // killough 03/07/98: Carry things on floor
+        // killough 03/20/98: Use new sector list which reflects true members
+        // killough 03/27/98: Fix carrier bug
+        // killough 04/04/98: Underwater, carry things even w/o gravity
+        sector_t    *sec = sectors + scroller->affectee;
+        fixed_t     height = sec->floorheight;
+        fixed_t     waterheight = (sec->heightsec && sec->heightsec->floorheight > height ? sec->heightsec->floorheight : FIXED_MIN);
+
+        // Move objects only if on floor or underwater,
+        // non-floating, and clipped.
+        for (msecnode_t *node = sec->touching_thinglist; node; node = node->m_snext)
+        {
+            mobj_t  *thing = node->m_thing;
+
+            if (!(thing->flags & MF_NOCLIP) && (!((thing->flags & MF_NOGRAVITY) || thing->z > height) || thing->z < waterheight))
+            {
+                if (thing->dormant)
+                    P_WakeMobj(thing);
+
+                thing->momx += dx;
+                thing->momy += dy;
+            }
+        }
     }
+}
 
-    if (!(dx | dy))                     // no-op if both (x,y) offsets 0
-        return;
+//
+// P_RunScrollers
+//
+// Moves the offsets of every wall, floor and ceiling scroller, a list of
+// each at a time. How far each control sector has moved is worked out once
+// first, however many scrollers it controls. Returns how many scrollers
+// were run.
+//
+int P_RunScrollers(void)
+{
+    int     prevaffectee = -1;
+    fixed_t dx, dy;
 
-    switch (scroller->type)
+    for (int i = 0; i < numscrollcontrolsectors; i++)
     {
-        case sc_side:                   // killough 03/07/98: Scroll wall texture
+        const sector_t  *sec = sectors + scrollcontrolsectors[i];
+        scrollcontrol_t *scrollcontrol = &scrollcontrols[scrollcontrolsectors[i]];
+        const fixed_t   height = sec->floorheight + sec->ceilingheight;
+
+        scrollcontrol->delta = height - scrollcontrol->lastheight;
+        scrollcontrol->lastheight = height;
+    }
+
+    for (int i = 0; i < sidescrollers.count; i++)
+    {
+        scroll_t    *scroller = sidescrollers.scrollers[i];
+
+        // [BH] only allow wall scrollers to update once per tic
+        if (scroller->affectee == prevaffectee)
+            continue;
+
+        prevaffectee = scroller->affectee;
+
+        // killough 03/07/98: Scroll wall texture
+        if (P_ScrollAmount(scroller, (scroller->control != -1 ? scrollcontrols[scroller->control].delta : 0), &dx, &dy))
         {
             side_t  *side = sides + scroller->affectee;
 
             side->textureoffset += dx;
             side->rowoffset += dy;
-            break;
         }
+    }
+
+    for (int i = 0; i < floorscrollers.count; i++)
+    {
+        scroll_t    *scroller = floorscrollers.scrollers[i];
 
-        case sc_floor:                  // killough 03/07/98: Scroll floor texture
+        // killough 03/07/98: Scroll floor texture
+        if (P_ScrollAmount(scroller, (scroller->control != -1 ? scrollcontrols[scroller->control].delta : 0), &dx, &dy))
         {
             sector_t    *sec = sectors + scroller->affectee;
 
             sec->floorxoffset += dx;
             sec->flooryoffset += dy;
-            break;
         }
+    }
+
+    for (int i = 0; i < ceilingscrollers.count; i++)
+    {
+        scroll_t    *scroller = ceilingscrollers.scrollers[i];
 
-        case sc_ceiling:                // killough 03/07/98: Scroll ceiling texture
+        // killough 03/07/98: Scroll ceiling texture
+        if (P_ScrollAmount(scroller, (scroller->control != -1 ? scrollcontrols[scroller->control].delta : 0), &dx, &dy))
         {
             sector_t    *sec = sectors + scroller->affectee;
 
             sec->ceilingxoffset += dx;
             sec->ceilingyoffset += dy;
-            break;
         }
+    }
 
-        case sc_carry:
-        {
-            // killough 03/07/98: Carry things on floor
-            // killough 03/20/98: Use new sector list which reflects true members
-            // killough 03/27/98: Fix carrier bug
-            // killough 04/04/98: Underwater, carry things even w/o gravity
-            sector_t    *sec = sectors + scroller->affectee;
-            fixed_t     height = sec->floorheight;
-            fixed_t     waterheight = (sec->heightsec && sec->heightsec->floorheight > height ? sec->heightsec->floorheight : FIXED_MIN);
+    return (sidescrollers.count + floorscrollers.count + ceilingscrollers.count);
+}
 
-            // Move objects only if on floor or underwater,
-            // non-floating, and clipped.
-            for (msecnode_t *node = sec->touching_thinglist; node; node = node->m_snext)
-            {
-                mobj_t  *thing = node->m_thing;
+//
+// P_AddScroller
+//
+// Adds a scroller to the list for its type, or to the thinker list if it's
+// a carrier. A scroller's control sector takes its last known height from
+// the first scroller it controls.
+//
+void P_AddScroller(scroll_t *scroller)
+{
+    scrollerlist_t  *list;
 
-                if (!(thing->flags & MF_NOCLIP) && (!((thing->flags & MF_NOGRAVITY) || thing->z > height) || thing->z < waterheight))
-                {
-                    thing->momx += dx;
-                    thing->momy += dy;
-                }
-            }
+    switch (scroller->type)
+    {
+        case sc_side:
+            list = &sidescrollers;
+            break;
+
+        case sc_floor:
+            list = &floorscrollers;
+            break;
 
+        case sc_ceiling:
+            list = &ceilingscrollers;
             break;
+
+        default:
+            scroller->thinker.function = &T_Scroll;
+            scroller->thinker.menu = false;
+            P_AddThinker(&scroller->thinker);
+            return;
+    }
+
+    if (list->count == list->max)
+    {
+        list->max = (list->max ? list->max * 2 : 64);
+        list->scrollers = I_Realloc(list->scrollers, list->max * sizeof(*list->scrollers));
+    }
+
+    list->scrollers[list->count++] = scroller;
+
+    if (scroller->control != -1 && !scrollcontrols[scroller->control].used)
+    {
+        scrollcontrol_t *scrollcontrol = &scrollcontrols[scroller->control];
+
+        scrollcontrol->used = true;
+        scrollcontrol->lastheight = scroller->lastheight;
+        scrollcontrol->delta = 0;
+
+        if (numscrollcontrolsectors == maxscrollcontrolsectors)
+        {
+            maxscrollcontrolsectors = (maxscrollcontrolsectors ? maxscrollcontrolsectors * 2 : 16);
+            scrollcontrolsectors = I_Realloc(scrollcontrolsectors,
+                maxscrollcontrolsectors * sizeof(*scrollcontrolsectors));
         }
+
+        scrollcontrolsectors[numscrollcontrolsectors++] = scroller->control;
     }
 }
 
+//
+// P_RemoveScrollers
+//
+// Frees every wall, floor and ceiling scroller, before a savegame's are
+// loaded in their place.
+//
+void P_RemoveScrollers(void)
+{
+    scrollerlist_t  *lists[] = { &sidescrollers, &floorscrollers, &ceilingscrollers };
+
+    for (int i = 0; i < arrlen(lists); i++)
+    {
+        for (int j = 0; j < lists[i]->count; j++)
+            Z_Free(lists[i]->scrollers[j]);
+
+        lists[i]->count = 0;
+    }
+
+    for (int i = 0; i < numscrollcontrolsectors; i++)
+        scrollcontrols[scrollcontrolsectors[i]].used = false;
+
+    numscrollcontrolsectors = 0;
+}
+
 //
 // Add_Scroller()
 //
-// Add a generalized scroller to the thinker list.
+// Add a generalized scroller.
 //
 // type: the enumerated type of scrolling: floor, ceiling, floor carrier,
 //   wall, floor carrier and scroller
@@ -2811,9 +2995,7 @@ static void Add_Scroller(int type, fixed_t dx, fixed_t dy, int control, int affe
         scroller->lastheight = sectors[control].floorheight + sectors[control].ceilingheight;
 
     scroller->affectee = affectee;
-    scroller->thinker.function = &T_Scroll;
-    scroller->thinker.menu = (type != sc_carry);
-    P_AddThinker(&scroller->thinker);
+    P_AddScroller(scroller);
 }
 
 // Adds wall scroller. Scroll amount is rotated with respect to wall's
@@ -2844,6 +3026,13 @@ static void P_SpawnScrollers(void)
 {
     line_t  *line = lines;
 
+    // the scrollers themselves were freed with the last level
+    scrollcontrols = Z_Calloc(numsectors, sizeof(*scrollcontrols), PU_LEVEL, NULL);
+    numscrollcontrolsectors = 0;
+    sidescrollers.count = 0;
+    floorscrollers.count = 0;
+    ceilingscrollers.count = 0;
+
     for (int i = 0; i < numlines; i++, line++)
     {
         fixed_t dx = line->dx >> SCROLL_SHIFT;                              // direction and speed of scrolling
@@ -3156,6 +3345,10 @@ static bool PIT_PushThing(mobj_t *thing)
                 pushangle += ANG180;    // away
 
             pushangle >>= ANGLETOFINESHIFT;
+
+            if (thing->dormant)
+                P_WakeMobj(thing);
+
             thing->momx += FixedMul(speed, finecosine[pushangle]);
             thing->momy += FixedMul(speed, finesine[pushangle]);
         }
@@ -3299,6 +3492,9 @@ void T_Pusher(pusher_t *pusher)
             }
         }
 
+        if (thing->dormant)
+            P_WakeMobj(thing);
+
         thing->momx += (xspeed << (FRACBITS - PUSH_FACTOR));
         thing->momy += (yspeed << (FRACBITS - PUSH_FACTOR));
     }
@@ -240,6 +240,7 @@ typedef struct
 #define BUTTONTIME  35
 
 extern button_t *buttonlist;
+extern int      numbuttons;
 extern int      maxbuttons;
 
 void P_InitSwitchList(void);
@@ -306,6 +307,7 @@ typedef struct platlist_s
 #define PLATSPEED   FRACUNIT
 
 extern platlist_t   *activeplats;
+extern slab_t       platslab;
 
 void T_PlatStay(plat_t *plat);
 void T_PlatRaise(plat_t *plat);
@@ -368,6 +370,8 @@ typedef struct
     int         lighttag;
 } vldoor_t;
 
+extern slab_t   doorslab;
+
 #define VDOORSPEED  (2 * FRACUNIT)
 #define VDOORWAIT   150
 
@@ -441,6 +445,7 @@ typedef struct ceilinglist_s
 #define CEILSPEED   FRACUNIT
 
 extern ceilinglist_t    *activeceilings;
+extern slab_t           ceilingslab;
 
 bool EV_DoCeiling(line_t *line, ceiling_e type);
 
@@ -532,6 +537,8 @@ typedef struct
     bool        stopsound;
 } floormove_t;
 
+extern slab_t   floorslab;
+
 typedef struct
 {
     thinker_t   thinker;
@@ -592,7 +599,29 @@ typedef struct
     scroll_e    type;           // Type of scroll effect
 } scroll_t;
 
+typedef struct
+{
+    scroll_t    **scrollers;
+    int         count;
+    int         max;
+} scrollerlist_t;
+
+typedef struct
+{
+    fixed_t     lastheight;     // Last known height of control sector
+    fixed_t     delta;          // How far that height changed this tic
+    bool        used;           // Whether any scroller in a list uses it
+} scrollcontrol_t;
+
+extern scrollerlist_t   sidescrollers;
+extern scrollerlist_t   floorscrollers;
+extern scrollerlist_t   ceilingscrollers;
+extern scrollcontrol_t  *scrollcontrols;
+
 void T_Scroll(scroll_t *scroller);
+int P_RunScrollers(void);
+void P_AddScroller(scroll_t *scroller);
+void P_RemoveScrollers(void);
 
 typedef enum
 {
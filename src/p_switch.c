@@ -51,6 +51,7 @@ static int  *switchlist;    // killough
 static int  numswitches;    // killough
 
 button_t    *buttonlist = NULL;
+int         numbuttons;
 int         maxbuttons = MAXBUTTONS;
 
 //
@@ -140,28 +141,26 @@ void P_InitSwitchList(void)
 //
 void P_StartButton(line_t *line, bwhere_e bwhere, int texture, int time)
 {
+    button_t    *button;
+
     // See if button is already pressed
-    for (int i = 0; i < maxbuttons; i++)
-        if (buttonlist[i].btimer && buttonlist[i].line == line)
+    for (int i = 0; i < numbuttons; i++)
+        if (buttonlist[i].line == line)
             return;
 
-    for (int i = 0; i < maxbuttons; i++)
-        if (!buttonlist[i].btimer)
-        {
-            buttonlist[i].line = line;
-            buttonlist[i].bwhere = bwhere;
-            buttonlist[i].btexture = texture;
-            buttonlist[i].btimer = time;
-            buttonlist[i].soundorg = &line->soundorg;
-
-            return;
-        }
-
     // [crispy] remove MAXBUTTONS limit
-    maxbuttons *= 2;
-    buttonlist = I_Realloc(buttonlist, maxbuttons * sizeof(*buttonlist));
-    memset(buttonlist + maxbuttons / 2, 0, ((size_t)maxbuttons - maxbuttons / 2) * sizeof(*buttonlist));
-    P_StartButton(line, bwhere, texture, time);
+    if (numbuttons == maxbuttons)
+    {
+        maxbuttons *= 2;
+        buttonlist = I_Realloc(buttonlist, maxbuttons * sizeof(*buttonlist));
+    }
+
+    button = &buttonlist[numbuttons++];
+    button->line = line;
+    button->bwhere = bwhere;
+    button->btexture = texture;
+    button->btimer = time;
+    button->soundorg = &line->soundorg;
 }
 
 //
@@ -35,6 +35,7 @@
 
 #include "c_console.h"
 #include "doomstat.h"
+#include "i_system.h"
 #include "m_config.h"
 #include "m_menu.h"
 #include "p_local.h"
@@ -55,14 +56,38 @@ int         maptime;
 // killough 08/29/98: we maintain several separate threads, each containing
 // a special class of thinkers, to allow more efficient searches.
 thinker_t   thinkers[th_all + 1];
+int         thinkercount[NUMTHCLASS];
+
+static const struct
+{
+    think_t     function;
+    int         thclass;
+} thinkerclasses[] =
+{
+    { &P_MobjThinker,  th_mobj        },
+    { &T_LightFlash,   th_flash       },
+    { &T_StrobeFlash,  th_strobe      },
+    { &T_Glow,         th_glow        },
+    { &T_FireFlicker,  th_fireflicker },
+    { &T_Scroll,       th_scroll      },
+    { &T_Pusher,       th_pusher      },
+    { &T_VerticalDoor, th_mover       },
+    { &T_MoveFloor,    th_mover       },
+    { &T_MoveCeiling,  th_mover       },
+    { &T_CeilingStay,  th_mover       },
+    { &T_PlatRaise,    th_mover       },
+    { &T_PlatStay,     th_mover       },
+    { &T_MoveElevator, th_mover       }
+};
 
 //
 // P_InitThinkers
 //
 void P_InitThinkers(void)
 {
-    thinkers[th_mobj].cprev = thinkers[th_mobj].cnext = &thinkers[th_mobj];
-    thinkers[th_misc].cprev = thinkers[th_misc].cnext = &thinkers[th_misc];
+    for (int i = 0; i < NUMTHCLASS; i++)
+        thinkers[i].cprev = thinkers[i].cnext = &thinkers[i];
+
     thinkers[th_all].prev = thinkers[th_all].next = &thinkers[th_all];
 }
 
@@ -78,7 +103,15 @@ void P_UpdateThinker(thinker_t *thinker)
         (th->cprev = thinker->cprev)->cnext = th;
 
     // Add to appropriate thread
-    th = &thinkers[(thinker->function == &P_MobjThinker ? th_mobj : th_misc)];
+    th = &thinkers[th_misc];
+
+    for (int i = 0; i < arrlen(thinkerclasses); i++)
+        if (thinker->function == thinkerclasses[i].function)
+        {
+            th = &thinkers[thinkerclasses[i].thclass];
+            break;
+        }
+
     th->cprev->cnext = thinker;
     thinker->cnext = th;
     thinker->cprev = th->cprev;
@@ -198,6 +231,51 @@ void P_SetTarget(mobj_t **mop, mobj_t *targ)
         targ->thinker.references++;
 }
 
+//
+// P_CheckMonsterSights
+// Checks in parallel whether each monster about to change state can see
+// its target and the player, so that the checks it makes while doing so
+// are answered from the sight cache.
+//
+static void P_CheckMonsterSights(void)
+{
+    static mobj_t   **lookers;
+    static mobj_t   **targets;
+    static int      maxcount;
+    int             count = 0;
+    mobj_t          *playermo = viewplayer->mo;
+
+    for (thinker_t *th = thinkers[th_mobj].cnext; th != &thinkers[th_mobj]; th = th->cnext)
+    {
+        mobj_t  *mo = (mobj_t *)th;
+
+        if (th->function != &P_MobjThinker || mo->dormant || mo->player || mo->tics != 1 || !sentient(mo))
+            continue;
+
+        if (count + 2 > maxcount)
+        {
+            maxcount = (maxcount ? maxcount * 2 : 256);
+            lookers = I_Realloc(lookers, maxcount * sizeof(*lookers));
+            targets = I_Realloc(targets, maxcount * sizeof(*targets));
+        }
+
+        if (mo->target && mo->target != mo)
+        {
+            lookers[count] = mo;
+            targets[count++] = mo->target;
+        }
+
+        if (playermo && mo->target != playermo)
+        {
+            lookers[count] = mo;
+            targets[count++] = playermo;
+        }
+    }
+
+    if (count)
+        P_CheckSights(lookers, targets, count);
+}
+
 //
 // P_Ticker
 //
@@ -217,9 +295,15 @@ void P_Ticker(void)
         {
             animatedtic++;
 
-            for (currentthinker = thinkers[th_misc].cnext; currentthinker != &thinkers[th_misc]; currentthinker = currentthinker->cnext)
-                if (currentthinker->menu)
-                    currentthinker->function((mobj_t *)currentthinker);
+            for (int i = th_mobj + 1; i < NUMTHCLASS; i++)
+            {
+                for (currentthinker = thinkers[i].cnext; currentthinker != &thinkers[i]; currentthinker = currentthinker->cnext)
+                    if (currentthinker->menu)
+                        currentthinker->function((mobj_t *)currentthinker);
+
+                if (i == th_scroll)
+                    P_RunScrollers();
+            }
         }
 
         P_UpdateSpecials();
@@ -236,11 +320,42 @@ void P_Ticker(void)
         return;
     }
 
+    if (numdormantmobjs && !dormantmonsters)
+        P_WakeDormantMobjs();
+
+    P_CheckMonsterSights();
+
+    thinkercount[th_mobj] = 0;
+
     for (currentthinker = thinkers[th_mobj].cnext; currentthinker != &thinkers[th_mobj]; currentthinker = currentthinker->cnext)
-        currentthinker->function((mobj_t *)currentthinker);
+    {
+        mobj_t  *mobj = (mobj_t *)currentthinker;
 
-    for (currentthinker = thinkers[th_misc].cnext; currentthinker != &thinkers[th_misc]; currentthinker = currentthinker->cnext)
-        currentthinker->function((mobj_t *)currentthinker);
+        // dormant monsters stay in the list for everything else that looks
+        // through it, and only count the tics they miss
+        if (mobj->dormant)
+            mobj->dormanttics++;
+        else
+        {
+            currentthinker->function(mobj);
+            thinkercount[th_mobj]++;
+        }
+    }
+
+    for (int i = th_mobj + 1; i < NUMTHCLASS; i++)
+    {
+        thinkercount[i] = 0;
+
+        for (currentthinker = thinkers[i].cnext; currentthinker != &thinkers[i]; currentthinker = currentthinker->cnext)
+        {
+            currentthinker->function((mobj_t *)currentthinker);
+            thinkercount[i]++;
+        }
+
+        // only carriers are thinkers, so move every other scroller now
+        if (i == th_scroll)
+            thinkercount[i] += P_RunScrollers();
+    }
 
     P_UpdateSpecials();
     T_MAPMusic();
@@ -54,12 +54,24 @@ void P_SetTarget(mobj_t **mop, mobj_t *targ);           // killough 11/98
 // killough 08/29/98: threads of thinkers, for more efficient searches
 // cph 01/13/02: for consistency with the main thinker list, keep objects
 // pending deletion on a class list too
+// Specials are split by function, so P_Ticker() runs all the thinkers of
+// each kind together, in this order. Doors, floors, ceilings, platforms and
+// elevators can move the same sectors, so they share th_mover and still run
+// in the order they were added.
 enum
 {
     th_mobj,
+    th_flash,
+    th_strobe,
+    th_glow,
+    th_fireflicker,
+    th_scroll,
+    th_pusher,
+    th_mover,
     th_misc,
     NUMTHCLASS,
     th_all = NUMTHCLASS
 };
 
 extern thinker_t    thinkers[];
+extern int          thinkercount[NUMTHCLASS];   // run in each class last tic
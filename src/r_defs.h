@@ -138,6 +138,10 @@ typedef struct sector_s
     int                 linecount;
     struct line_s       **lines;                // [linecount] size
 
+    // two-sided lines to adjacent sectors, for sound propagation
+    int                 numsoundlinks;
+    struct soundlink_s  *soundlinks;            // [numsoundlinks] size
+
     int                 cachedheight;
 
     // [AM] Previous position of floor and ceiling before
@@ -301,6 +305,21 @@ typedef struct line_s
     degenmobj_t         soundorg;
 } line_t;
 
+//
+// A two-sided line as seen from one of its sectors, built by P_GroupLines()
+// so P_NoiseAlert() doesn't need to look up the sector on the other side.
+// Whether the line is open is only worked out again once one of its sectors
+// has moved.
+//
+typedef struct soundlink_s
+{
+    sector_t            *sector;        // sector on the other side
+    line_t              *line;
+    bool                soundblock;     // ML_SOUNDBLOCK is set
+    bool                open;
+    int                 checkedtime;    // gametime open was last worked out
+} soundlink_t;
+
 enum
 {
     DR_Door_OpenWaitClose_AlsoMonsters                                                =    1,
@@ -175,7 +175,7 @@ static void CreatePatch(int patchnum)
 
     // allocate our data chunk
     datasize = pixeldatasize + columnsdatasize + postsdatasize;
-    patch->data = Z_Calloc(1, datasize, PU_CACHE, (void **)&patch->data);
+    patch->data = Z_Calloc(1, datasize, PU_STATIC, (void **)&patch->data);
 
     // set out pixel, column, and post pointers into our data array
     patch->pixels = patch->data;
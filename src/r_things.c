@@ -664,6 +664,9 @@ static void R_ProjectSprite(mobj_t *thing)
     if (thing->player && thing->player->mo == thing)
         return;
 
+    if (thing->dormant)
+        P_CatchUpDormantMobj(thing);
+
     // [AM] Interpolate between current and last position, if prudent.
     if (thing->interpolate && interpolatesprites)
     {
@@ -186,43 +186,235 @@ void V_FillSoftTransRect(int screen, int x, int y, int width, int height, int co
 }
 
 //
-// V_DrawPatch
-// Masks a column based masked pic to the screen.
+// Patch draw lists
 //
-void V_DrawPatch(int x, int y, int screen, patch_t *patch)
+// The first time a patch is drawn by one of the V_Draw*Patch functions below,
+// its columns and posts are parsed and rasterized at the required scale into
+// a list of horizontal runs, which is then reused by every subsequent draw of
+// that patch. Scaled and unscaled lists are kept separately.
+//
+#define PATCHDRAWLISTHASHSIZE   1024
+
+typedef struct
 {
-    byte        *desttop;
-    const int   width = SHORT(patch->width) << FRACBITS;
+    short   x;
+    short   y;
+    short   length;
+    int     offset;
+} patchrun_t;
 
-    y -= SHORT(patch->topoffset);
-    x -= SHORT(patch->leftoffset);
-    x += WIDESCREENDELTA;
+typedef struct patchdrawlist_s
+{
+    const patch_t           *patch;
+    bool                    scaled;
 
-    desttop = &screens[screen][((y * DY) >> FRACBITS) * SCREENWIDTH + ((x * DX) >> FRACBITS)];
+    int                     width;
+    int                     numruns;
+    patchrun_t              *runs;
+    byte                    *pixels;
 
-    for (int col = 0; col < width; col += DXI, desttop++)
+    struct patchdrawlist_s  *next;
+} patchdrawlist_t;
+
+static patchdrawlist_t  *patchdrawlists[PATCHDRAWLISTHASHSIZE];
+static int              numpatchdrawlists;
+
+static patchdrawlist_t *V_BuildPatchDrawList(const patch_t *patch, bool scaled)
+{
+    const int       patchwidth = SHORT(patch->width);
+    const fixed_t   xstep = (scaled ? DXI : FRACUNIT);
+    const fixed_t   ystep = (scaled ? DYI : FRACUNIT);
+    const fixed_t   yscale = (scaled ? DY : FRACUNIT);
+    int             width = 0;
+    int             height = 0;
+    int             numruns = 0;
+    int             numpixels = 0;
+    byte            *canvas;
+    bool            *opaque;
+    patchdrawlist_t *list;
+    patchrun_t      *run;
+    byte            *pixels;
+
+    // work out the size of the patch once it is scaled
+    for (int col = 0; col < (patchwidth << FRACBITS); col += xstep, width++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[col >> FRACBITS]));
+        const column_t  *column = (const column_t *)((const byte *)patch + LONG(patch->columnoffset[col >> FRACBITS]));
 
-        // step through the posts in a column
         while (column->topdelta != 0xFF)
         {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[((column->topdelta * DY) >> FRACBITS) * SCREENWIDTH];
-            const byte  length = column->length;
-            int         count = (length * DY) >> FRACBITS;
-            int         srccol = 0;
+            height = MAX(height, ((column->topdelta * yscale) >> FRACBITS) + ((column->length * yscale) >> FRACBITS));
+            column = (const column_t *)((const byte *)column + column->length + 4);
+        }
+    }
 
-            while (count-- > 0)
+    // rasterize the posts in exactly the same order that they would be drawn
+    canvas = calloc((size_t)width * height + 1, sizeof(*canvas));
+    opaque = calloc((size_t)width * height + 1, sizeof(*opaque));
+
+    for (int col = 0, x = 0; x < width; col += xstep, x++)
+    {
+        const column_t  *column = (const column_t *)((const byte *)patch + LONG(patch->columnoffset[col >> FRACBITS]));
+
+        while (column->topdelta != 0xFF)
+        {
+            const byte  *source = (const byte *)column + 3;
+            const int   top = (column->topdelta * yscale) >> FRACBITS;
+            const int   count = (column->length * yscale) >> FRACBITS;
+
+            for (int i = 0, srccol = 0; i < count; i++, srccol += ystep)
             {
-                *dest = source[srccol >> FRACBITS];
-                dest += SCREENWIDTH;
-                srccol += DYI;
+                canvas[(top + i) * width + x] = source[srccol >> FRACBITS];
+                opaque[(top + i) * width + x] = true;
             }
 
-            column = (column_t *)((byte *)column + length + 4);
+            column = (const column_t *)((const byte *)column + column->length + 4);
         }
     }
+
+    // count the horizontal runs of opaque pixels
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+            if (opaque[y * width + x])
+            {
+                numpixels++;
+
+                if (!x || !opaque[y * width + x - 1])
+                    numruns++;
+            }
+
+    // allocate the list, its runs and their pixels in one block
+    // (this is kept out of the zone, since it is freed from within Z_Free())
+    if (!(list = malloc(sizeof(*list) + numruns * sizeof(*run) + numpixels)))
+        I_Error("V_BuildPatchDrawList: Failure trying to allocate a draw list");
+
+    list->patch = patch;
+    list->scaled = scaled;
+    list->width = width;
+    list->numruns = numruns;
+    list->runs = run = (patchrun_t *)(list + 1);
+    list->pixels = pixels = (byte *)(list->runs + numruns);
+
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+            if (opaque[y * width + x])
+            {
+                if (!x || !opaque[y * width + x - 1])
+                {
+                    run->x = x;
+                    run->y = y;
+                    run->length = 0;
+                    run->offset = (int)(pixels - list->pixels);
+                    run++;
+                }
+
+                (run - 1)->length++;
+                *pixels++ = canvas[y * width + x];
+            }
+
+    free(canvas);
+    free(opaque);
+
+    return list;
+}
+
+static const patchdrawlist_t *V_GetPatchDrawList(const patch_t *patch, bool scaled)
+{
+    const int       hash = (int)(((uintptr_t)patch >> 3) % PATCHDRAWLISTHASHSIZE);
+    patchdrawlist_t *list;
+
+    for (list = patchdrawlists[hash]; list; list = list->next)
+        if (list->patch == patch && list->scaled == scaled)
+            return list;
+
+    list = V_BuildPatchDrawList(patch, scaled);
+    list->next = patchdrawlists[hash];
+    patchdrawlists[hash] = list;
+    numpatchdrawlists++;
+
+    return list;
+}
+
+//
+// V_FreePatchDrawLists
+// Frees the draw lists built for a patch. This is called by Z_Free() for
+// every block it frees, so that a list can never outlive its patch and be
+// found again by another patch later loaded at the same address.
+//
+void V_FreePatchDrawLists(const void *ptr)
+{
+    patchdrawlist_t **link;
+
+    if (!numpatchdrawlists)
+        return;
+
+    link = &patchdrawlists[((uintptr_t)ptr >> 3) % PATCHDRAWLISTHASHSIZE];
+
+    while (*link)
+    {
+        patchdrawlist_t *list = *link;
+
+        if ((const void *)list->patch == ptr)
+        {
+            *link = list->next;
+            free(list);
+            numpatchdrawlists--;
+        }
+        else
+            link = &list->next;
+    }
+}
+
+//
+// V_FreePatchDrawListsInRange
+// Frees the draw lists of every patch within a block of memory that is
+// being released all at once, such as a zone arena or a mapped WAD.
+//
+void V_FreePatchDrawListsInRange(const void *start, const void *end)
+{
+    if (!numpatchdrawlists)
+        return;
+
+    for (int i = 0; i < PATCHDRAWLISTHASHSIZE; i++)
+    {
+        patchdrawlist_t **link = &patchdrawlists[i];
+
+        while (*link)
+        {
+            patchdrawlist_t *list = *link;
+
+            if ((const void *)list->patch >= start && (const void *)list->patch < end)
+            {
+                *link = list->next;
+                free(list);
+                numpatchdrawlists--;
+            }
+            else
+                link = &list->next;
+        }
+    }
+}
+
+//
+// V_DrawPatch
+// Masks a column based masked pic to the screen.
+//
+void V_DrawPatch(int x, int y, int screen, patch_t *patch)
+{
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, true);
+    byte                    *desttop;
+
+    y -= SHORT(patch->topoffset);
+    x -= SHORT(patch->leftoffset);
+    x += WIDESCREENDELTA;
+
+    desttop = &screens[screen][((y * DY) >> FRACBITS) * SCREENWIDTH + ((x * DX) >> FRACBITS)];
+
+    for (int i = 0; i < list->numruns; i++)
+    {
+        const patchrun_t    *run = &list->runs[i];
+
+        memcpy(&desttop[run->y * SCREENWIDTH + run->x], &list->pixels[run->offset], run->length);
+    }
 }
 
 void V_DrawWidePatch(int x, int y, int screen, patch_t *patch)
@@ -657,110 +849,66 @@ bool V_IsEmptyPatch(patch_t *patch)
 
 void V_DrawPatchToTempScreen(int x, int y, patch_t *patch)
 {
-    byte        *desttop;
-    const int   width = SHORT(patch->width) << FRACBITS;
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, true);
+    byte                    *desttop;
 
     y -= SHORT(patch->topoffset);
     x -= SHORT(patch->leftoffset);
 
     desttop = &tempscreen[((y * DY) >> FRACBITS) * SCREENWIDTH + ((x * DX) >> FRACBITS)];
 
-    for (int col = 0; col < width; col += DXI, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[col >> FRACBITS]));
+        const patchrun_t    *run = &list->runs[i];
+        const byte          *source = &list->pixels[run->offset];
+        byte                *dest = &desttop[run->y * SCREENWIDTH + run->x];
 
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
+        for (int j = 0; j < run->length; j++, dest++)
         {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[((column->topdelta * DY) >> FRACBITS) * SCREENWIDTH];
-            const byte  length = column->length;
-            int         count = (length * DY) >> FRACBITS;
-            int         srccol = 0;
-
-            while (count-- > 0)
-            {
-                *dest = source[srccol >> FRACBITS];
-                dest += SCREENWIDTH;
-
-                if (!vanilla)
-                    *(dest + SCREENWIDTH + 2) = nearestblack;
-
-                srccol += DYI;
-            }
+            *dest = *source++;
 
-            column = (column_t *)((byte *)column + length + 4);
+            if (!vanilla)
+                *(dest + 2 * (size_t)SCREENWIDTH + 2) = nearestblack;
         }
     }
 }
 
 void V_DrawHUDText(int x, int y, byte *screen, patch_t *patch, int screenwidth)
 {
-    byte        *desttop;
-    const int   width = SHORT(patch->width) << FRACBITS;
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, true);
+    byte                    *desttop;
 
     y -= SHORT(patch->topoffset) * SCREENSCALE;
     x -= SHORT(patch->leftoffset) * SCREENSCALE;
 
     desttop = &screen[y * screenwidth + x];
 
-    for (int col = 0; col < width; col += DXI, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[col >> FRACBITS]));
-
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
-        {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[((column->topdelta * DY) >> FRACBITS) * screenwidth];
-            const byte  length = column->length;
-            int         count = (length * DY) >> FRACBITS;
-            int         srccol = 0;
-
-            while (count-- > 0)
-            {
-                *dest = source[srccol >> FRACBITS];
-                dest += screenwidth;
-                srccol += DYI;
-            }
+        const patchrun_t    *run = &list->runs[i];
 
-            column = (column_t *)((byte *)column + length + 4);
-        }
+        memcpy(&desttop[run->y * screenwidth + run->x], &list->pixels[run->offset], run->length);
     }
 }
 
 void V_DrawTranslucentHUDText(int x, int y, byte *screen, patch_t *patch, int screenwidth)
 {
-    byte        *desttop;
-    const int   width = SHORT(patch->width) << FRACBITS;
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, true);
+    byte                    *desttop;
 
     y -= SHORT(patch->topoffset) * SCREENSCALE;
     x -= SHORT(patch->leftoffset) * SCREENSCALE;
 
     desttop = &screen[y * screenwidth + x];
 
-    for (int col = 0; col < width; col += DXI, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[col >> FRACBITS]));
-
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
-        {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[((column->topdelta * DY) >> FRACBITS) * screenwidth];
-            const byte  length = column->length;
-            int         count = (length * DY) >> FRACBITS;
-            int         srccol = 0;
-
-            while (count-- > 0)
-            {
-                *dest = tinttab25[(*dest << 8) + source[srccol >> FRACBITS]];
-                dest += screenwidth;
-                srccol += DYI;
-            }
+        const patchrun_t    *run = &list->runs[i];
+        const byte          *source = &list->pixels[run->offset];
+        byte                *dest = &desttop[run->y * screenwidth + run->x];
 
-            column = (column_t *)((byte *)column + length + 4);
-        }
+        for (int j = 0; j < run->length; j++, dest++)
+            *dest = tinttab25[(*dest << 8) + *source++];
     }
 }
 
@@ -893,202 +1041,133 @@ void V_DrawPatchWithShadow(int x, int y, patch_t *patch, bool flag)
 
 void V_DrawHUDPatch(int x, int y, patch_t *patch, const byte *tinttab)
 {
-    byte        *desttop = &screens[0][y * SCREENWIDTH + x];
-    const int   width = SHORT(patch->width);
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, false);
+    byte                    *desttop = &screens[0][y * SCREENWIDTH + x];
 
-    for (int col = 0; col < width; col++, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[col]));
-
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
-        {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[column->topdelta * SCREENWIDTH];
-            const byte  length = column->length;
-            byte        count = length;
-
-            while (count-- > 0)
-            {
-                *dest = *source++;
-                dest += SCREENWIDTH;
-            }
+        const patchrun_t    *run = &list->runs[i];
 
-            column = (column_t *)((byte *)column + length + 4);
-        }
+        memcpy(&desttop[run->y * SCREENWIDTH + run->x], &list->pixels[run->offset], run->length);
     }
 }
 
 void V_DrawHighlightedHUDNumberPatch(int x, int y, patch_t *patch, const byte *tinttab)
 {
-    byte        *desttop = &screens[0][y * SCREENWIDTH + x];
-    const int   width = SHORT(patch->width);
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, false);
+    byte                    *desttop = &screens[0][y * SCREENWIDTH + x];
 
-    for (int col = 0; col < width; col++, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[col]));
+        const patchrun_t    *run = &list->runs[i];
+        const byte          *source = &list->pixels[run->offset];
+        byte                *dest = &desttop[run->y * SCREENWIDTH + run->x];
 
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
+        for (int j = 0; j < run->length; j++, dest++)
         {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[column->topdelta * SCREENWIDTH];
-            const byte  length = column->length;
-            byte        count = length;
-
-            while (count-- > 0)
-            {
-                byte    dot = *source++;
-
-                *dest = (dot == 109 ? tinttab33[*dest] : gold15[dot]);
-                dest += SCREENWIDTH;
-            }
+            const byte  dot = *source++;
 
-            column = (column_t *)((byte *)column + length + 4);
+            *dest = (dot == 109 ? tinttab33[*dest] : gold15[dot]);
         }
     }
 }
 
 void V_DrawTranslucentHUDPatch(int x, int y, patch_t *patch, const byte *tinttab)
 {
-    byte        *desttop = &screens[0][y * SCREENWIDTH + x];
-    const int   width = SHORT(patch->width);
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, false);
+    byte                    *desttop = &screens[0][y * SCREENWIDTH + x];
 
-    for (int col = 0; col < width; col++, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[col]));
-
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
-        {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[column->topdelta * SCREENWIDTH];
-            const byte  length = column->length;
-            byte        count = length;
-
-            while (count-- > 0)
-            {
-                *dest = tinttab[(*source++ << 8) + *dest];
-                dest += SCREENWIDTH;
-            }
+        const patchrun_t    *run = &list->runs[i];
+        const byte          *source = &list->pixels[run->offset];
+        byte                *dest = &desttop[run->y * SCREENWIDTH + run->x];
 
-            column = (column_t *)((byte *)column + length + 4);
-        }
+        for (int j = 0; j < run->length; j++, dest++)
+            *dest = tinttab[(*source++ << 8) + *dest];
     }
 }
 
 void V_DrawTranslucentHUDNumberPatch(int x, int y, patch_t *patch, const byte *tinttab)
 {
-    byte        *desttop = &screens[0][y * SCREENWIDTH + x];
-    const int   width = SHORT(patch->width);
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, false);
+    byte                    *desttop = &screens[0][y * SCREENWIDTH + x];
 
-    for (int col = 0; col < width; col++, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[col]));
+        const patchrun_t    *run = &list->runs[i];
+        const byte          *source = &list->pixels[run->offset];
+        byte                *dest = &desttop[run->y * SCREENWIDTH + run->x];
 
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
+        for (int j = 0; j < run->length; j++, dest++)
         {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[column->topdelta * SCREENWIDTH];
-            const byte  length = column->length;
-            byte        count = length;
-
-            while (count-- > 0)
-            {
-                byte    dot = *source++;
+            const byte  dot = *source++;
 
-                *dest = (dot == 109 ? tinttab33[*dest] : tinttab[(dot << 8) + *dest]);
-                dest += SCREENWIDTH;
-            }
-
-            column = (column_t *)((byte *)column + length + 4);
+            *dest = (dot == 109 ? tinttab33[*dest] : tinttab[(dot << 8) + *dest]);
         }
     }
 }
 
 void V_DrawAltHUDPatch(int x, int y, patch_t *patch, int from, int to, const byte *tinttab)
 {
-    byte        *desttop = &screens[0][y * SCREENWIDTH + x];
-    const int   width = SHORT(patch->width);
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, false);
+    byte                    *desttop = &screens[0][y * SCREENWIDTH + x];
 
-    for (int col = 0; col < width; col++, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[col]));
+        const patchrun_t    *run = &list->runs[i];
+        const byte          *source = &list->pixels[run->offset];
+        byte                *dest = &desttop[run->y * SCREENWIDTH + run->x];
 
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
+        for (int j = 0; j < run->length; j++, dest++)
         {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[column->topdelta * SCREENWIDTH];
-            const byte  length = column->length;
-            byte        count = length;
+            const byte  dot = *source++;
 
-            while (count-- > 0)
-            {
-                byte    dot = *source++;
-
-                if (dot == from)
-                    *dest = to;
-                else if (dot)
-                    *dest = nearestcolors[dot];
-
-                dest += SCREENWIDTH;
-            }
-
-            column = (column_t *)((byte *)column + length + 4);
+            if (dot == from)
+                *dest = to;
+            else if (dot)
+                *dest = nearestcolors[dot];
         }
     }
 }
 
 void V_DrawTranslucentAltHUDPatch(int x, int y, patch_t *patch, int from, int to, const byte *tinttab)
 {
-    byte        *desttop = &screens[0][y * SCREENWIDTH + x];
-    const int   width = SHORT(patch->width);
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, false);
+    byte                    *desttop = &screens[0][y * SCREENWIDTH + x];
 
     if (tinttab)
         to <<= 8;
 
-    for (int col = 0; col < width; col++, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[col]));
+        const patchrun_t    *run = &list->runs[i];
+        const byte          *source = &list->pixels[run->offset];
+        byte                *dest = &desttop[run->y * SCREENWIDTH + run->x];
 
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
+        for (int j = 0; j < run->length; j++, dest++)
         {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[column->topdelta * SCREENWIDTH];
-            const byte  length = column->length;
-            byte        count = length;
+            const byte  dot = *source++;
 
-            while (count-- > 0)
+            if (dot == from)
+                *dest = (tinttab ? tinttab[to + *dest] : to);
+            else if (dot == DARKGRAY1)
+                *dest = tinttab20[(nearestwhite << 8) + *dest];
+            else if (dot)
             {
-                byte    dot = *source++;
-
-                if (dot == from)
-                    *dest = (tinttab ? tinttab[to + *dest] : to);
-                else if (dot == DARKGRAY1)
+                if (from == -1)
                     *dest = tinttab20[(nearestwhite << 8) + *dest];
-                else if (dot)
-                {
-                    if (from == -1)
-                        *dest = tinttab20[(nearestwhite << 8) + *dest];
-                    else if (tinttab)
-                        *dest = tinttab[(nearestcolors[dot] << 8) + *dest];
-                }
-
-                dest += SCREENWIDTH;
+                else if (tinttab)
+                    *dest = tinttab[(nearestcolors[dot] << 8) + *dest];
             }
-
-            column = (column_t *)((byte *)column + length + 4);
         }
     }
 }
 
 void V_DrawTranslucentRedPatch(int x, int y, patch_t *patch)
 {
-    byte        *desttop;
-    const int   width = SHORT(patch->width) << FRACBITS;
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, true);
+    byte                    *desttop;
 
     y -= SHORT(patch->topoffset);
     x -= SHORT(patch->leftoffset);
@@ -1096,28 +1175,14 @@ void V_DrawTranslucentRedPatch(int x, int y, patch_t *patch)
 
     desttop = &screens[0][((y * DY) >> FRACBITS) * SCREENWIDTH + ((x * DX) >> FRACBITS)];
 
-    for (int col = 0; col < width; col += DXI, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[col >> FRACBITS]));
+        const patchrun_t    *run = &list->runs[i];
+        const byte          *source = &list->pixels[run->offset];
+        byte                *dest = &desttop[run->y * SCREENWIDTH + run->x];
 
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
-        {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[((column->topdelta * DY) >> FRACBITS) * SCREENWIDTH];
-            const byte  length = column->length;
-            int         count = (length * DY) >> FRACBITS;
-            int         srccol = 0;
-
-            while (count-- > 0)
-            {
-                *dest = tinttabred[(*dest << 8) + source[srccol >> FRACBITS]];
-                dest += SCREENWIDTH;
-                srccol += DYI;
-            }
-
-            column = (column_t *)((byte *)column + length + 4);
-        }
+        for (int j = 0; j < run->length; j++, dest++)
+            *dest = tinttabred[(*dest << 8) + *source++];
     }
 }
 
@@ -1135,8 +1200,8 @@ void V_DrawTranslucentRedPatch(int x, int y, patch_t *patch)
 //
 void V_DrawFlippedPatch(int x, int y, patch_t *patch)
 {
-    byte        *desttop;
-    const int   width = SHORT(patch->width) << FRACBITS;
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, true);
+    byte                    *desttop;
 
     y -= SHORT(patch->topoffset);
     x -= SHORT(patch->leftoffset);
@@ -1144,28 +1209,14 @@ void V_DrawFlippedPatch(int x, int y, patch_t *patch)
 
     desttop = &screens[0][((y * DY) >> FRACBITS) * SCREENWIDTH + ((x * DX) >> FRACBITS)];
 
-    for (int col = 0; col < width; col += DXI, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[SHORT(patch->width) - 1 - (col >> FRACBITS)]));
+        const patchrun_t    *run = &list->runs[i];
+        const byte          *source = &list->pixels[run->offset + run->length - 1];
+        byte                *dest = &desttop[run->y * SCREENWIDTH + list->width - run->x - run->length];
 
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
-        {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[((column->topdelta * DY) >> FRACBITS) * SCREENWIDTH];
-            const byte  length = column->length;
-            int         count = (length * DY) >> FRACBITS;
-            int         srccol = 0;
-
-            while (count-- > 0)
-            {
-                *dest = source[srccol >> FRACBITS];
-                dest += SCREENWIDTH;
-                srccol += DYI;
-            }
-
-            column = (column_t *)((byte *)column + length + 4);
-        }
+        for (int j = 0; j < run->length; j++)
+            *dest++ = *source--;
     }
 }
 
@@ -1293,8 +1344,8 @@ void V_DrawFlippedSpectreShadowPatch(int x, int y, patch_t *patch)
 
 void V_DrawFlippedTranslucentRedPatch(int x, int y, patch_t *patch)
 {
-    byte        *desttop;
-    const int   width = SHORT(patch->width) << FRACBITS;
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, true);
+    byte                    *desttop;
 
     y -= SHORT(patch->topoffset);
     x -= SHORT(patch->leftoffset);
@@ -1302,28 +1353,14 @@ void V_DrawFlippedTranslucentRedPatch(int x, int y, patch_t *patch)
 
     desttop = &screens[0][((y * DY) >> FRACBITS) * SCREENWIDTH + ((x * DX) >> FRACBITS)];
 
-    for (int col = 0; col < width; col += DXI, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[SHORT(patch->width) - 1 - (col >> FRACBITS)]));
-
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
-        {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[((column->topdelta * DY) >> FRACBITS) * SCREENWIDTH];
-            const byte  length = column->length;
-            int         count = (length * DY) >> FRACBITS;
-            int         srccol = 0;
-
-            while (count-- > 0)
-            {
-                *dest = tinttabred[(*dest << 8) + source[srccol >> FRACBITS]];
-                dest += SCREENWIDTH;
-                srccol += DYI;
-            }
+        const patchrun_t    *run = &list->runs[i];
+        const byte          *source = &list->pixels[run->offset + run->length - 1];
+        byte                *dest = &desttop[run->y * SCREENWIDTH + list->width - run->x - run->length];
 
-            column = (column_t *)((byte *)column + length + 4);
-        }
+        for (int j = 0; j < run->length; j++, dest++)
+            *dest = tinttabred[(*dest << 8) + *source--];
     }
 }
 
@@ -1425,8 +1462,8 @@ static const byte nogreen[256] =
 
 void V_DrawNoGreenPatchWithShadow(int x, int y, patch_t *patch)
 {
-    byte        *desttop;
-    const int   width = SHORT(patch->width) << FRACBITS;
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, true);
+    byte                    *desttop;
 
     y -= SHORT(patch->topoffset);
     x -= SHORT(patch->leftoffset);
@@ -1434,47 +1471,34 @@ void V_DrawNoGreenPatchWithShadow(int x, int y, patch_t *patch)
 
     desttop = &screens[0][((y * DY) >> FRACBITS) * SCREENWIDTH + ((x * DX) >> FRACBITS)];
 
-    for (int col = 0; col < width; col += DXI, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[col >> FRACBITS]));
+        const patchrun_t    *run = &list->runs[i];
+        const byte          *source = &list->pixels[run->offset];
+        byte                *dest = &desttop[run->y * SCREENWIDTH + run->x];
 
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
+        for (int j = 0; j < run->length; j++, dest++)
         {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[((column->topdelta * DY) >> FRACBITS) * SCREENWIDTH];
-            const byte  length = column->length;
-            int         count = (length * DY) >> FRACBITS;
-            int         srccol = 0;
+            const byte  src = *source++;
 
-            while (count-- > 0)
+            if (nogreen[src])
             {
-                byte    src = source[srccol >> FRACBITS];
+                byte    *dot;
 
-                if (nogreen[src])
-                {
-                    byte    *dot;
-
-                    *dest = src;
-                    dot = dest + 2 * (size_t)SCREENWIDTH + 2;
+                *dest = src;
+                dot = dest + 2 * (size_t)SCREENWIDTH + 2;
 
-                    if (*dot != 47 && *dot != 191)
-                        *dot = black40[*dot];
-                }
-
-                dest += SCREENWIDTH;
-                srccol += DYI;
+                if (*dot != 47 && *dot != 191)
+                    *dot = black40[*dot];
             }
-
-            column = (column_t *)((byte *)column + length + 4);
         }
     }
 }
 
 void V_DrawTranslucentNoGreenPatch(int x, int y, patch_t *patch)
 {
-    byte        *desttop;
-    const int   width = SHORT(patch->width) << FRACBITS;
+    const patchdrawlist_t   *list = V_GetPatchDrawList(patch, true);
+    byte                    *desttop;
 
     y -= SHORT(patch->topoffset);
     x -= SHORT(patch->leftoffset);
@@ -1482,31 +1506,18 @@ void V_DrawTranslucentNoGreenPatch(int x, int y, patch_t *patch)
 
     desttop = &screens[0][((y * DY) >> FRACBITS) * SCREENWIDTH + ((x * DX) >> FRACBITS)];
 
-    for (int col = 0; col < width; col += DXI, desttop++)
+    for (int i = 0; i < list->numruns; i++)
     {
-        column_t    *column = (column_t *)((byte *)patch + LONG(patch->columnoffset[col >> FRACBITS]));
+        const patchrun_t    *run = &list->runs[i];
+        const byte          *source = &list->pixels[run->offset];
+        byte                *dest = &desttop[run->y * SCREENWIDTH + run->x];
 
-        // step through the posts in a column
-        while (column->topdelta != 0xFF)
+        for (int j = 0; j < run->length; j++, dest++)
         {
-            byte        *source = (byte *)column + 3;
-            byte        *dest = &desttop[((column->topdelta * DY) >> FRACBITS) * SCREENWIDTH];
-            const byte  length = column->length;
-            int         count = (length * DY) >> FRACBITS;
-            int         srccol = 0;
-
-            while (count-- > 0)
-            {
-                byte    src = source[srccol >> FRACBITS];
-
-                if (nogreen[src])
-                    *dest = tinttab33[(*dest << 8) + src];
+            const byte  src = *source++;
 
-                dest += SCREENWIDTH;
-                srccol += DYI;
-            }
-
-            column = (column_t *)((byte *)column + length + 4);
+            if (nogreen[src])
+                *dest = tinttab33[(*dest << 8) + src];
         }
     }
 }
@@ -103,6 +103,8 @@ void V_DrawShadowPatch(int x, int y, patch_t *patch);
 void V_DrawSolidShadowPatch(int x, int y, patch_t *patch);
 void V_DrawSpectreShadowPatch(int x, int y, patch_t *patch);
 bool V_IsEmptyPatch(patch_t *patch);
+void V_FreePatchDrawLists(const void *ptr);
+void V_FreePatchDrawListsInRange(const void *start, const void *end);
 void V_DrawPatchWithShadow(int x, int y, patch_t *patch, bool flag);
 void V_DrawFlippedPatch(int x, int y, patch_t *patch);
 void V_DrawFlippedShadowPatch(int x, int y, patch_t *patch);
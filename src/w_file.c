@@ -36,9 +36,13 @@
 #if defined(_WIN32)
 #include <Windows.h>
 #include <stdlib.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
 #endif
 
 #include "m_misc.h"
+#include "v_video.h"
 #include "w_file.h"
 #include "z_zone.h"
 
@@ -53,20 +57,75 @@ wadfile_t *W_OpenFile(char *path)
     // Create a new wadfile_t to hold the file handle.
     result = Z_Malloc(sizeof(wadfile_t), PU_STATIC, NULL);
     result->fstream = fstream;
+    result->mapped = NULL;
+    result->length = 0;
+
+#if !defined(_WIN32)
+    {
+        // Map the whole file copy-on-write, so lumps can be used straight
+        // from the mapping and any lump that is changed in place gets its
+        // own private pages rather than changing the file.
+        struct stat status;
+
+        if (!fstat(fileno(fstream), &status) && status.st_size > 0)
+        {
+            void    *mapped = mmap(NULL, (size_t)status.st_size, (PROT_READ | PROT_WRITE), MAP_PRIVATE,
+                        fileno(fstream), 0);
+
+            if (mapped != MAP_FAILED)
+            {
+                result->mapped = mapped;
+                result->length = (size_t)status.st_size;
+            }
+        }
+    }
+#endif
 
     return result;
 }
 
 void W_CloseFile(wadfile_t *wad)
 {
+#if !defined(_WIN32)
+    if (wad->mapped)
+    {
+        V_FreePatchDrawListsInRange(wad->mapped, wad->mapped + wad->length);
+        munmap(wad->mapped, wad->length);
+    }
+#endif
+
     fclose(wad->fstream);
     Z_Free(wad);
 }
 
+// Return a pointer to data at the specified position in a mapped file,
+// or NULL if the file isn't mapped or the data can't be used in place.
+byte *W_MappedData(wadfile_t *wad, unsigned int offset, size_t length)
+{
+    // Lumps that aren't aligned to 4 bytes are still copied, since some
+    // of them are read directly as structs containing ints.
+    if (!wad->mapped || (offset & 3) || offset > wad->length || length > wad->length - offset)
+        return NULL;
+
+    return (wad->mapped + offset);
+}
+
 // Read data from the specified position in the file into the
 // provided buffer. Returns the number of bytes read.
 size_t W_Read(wadfile_t *wad, unsigned int offset, void *buffer, size_t buffer_len)
 {
+    if (wad->mapped)
+    {
+        if (offset >= wad->length)
+            return 0;
+
+        if (buffer_len > wad->length - offset)
+            buffer_len = wad->length - offset;
+
+        memcpy(buffer, wad->mapped + offset, buffer_len);
+        return buffer_len;
+    }
+
     // Jump to the specified position in the file.
     fseek(wad->fstream, offset, SEEK_SET);
 
@@ -37,6 +37,8 @@
 
 #include <stdio.h>
 
+#include "doomtype.h"
+
 #if defined(_WIN32)
 #include <io.h>
 #include <sys/stat.h>
@@ -50,6 +52,8 @@
 typedef struct
 {
     FILE    *fstream;
+    byte    *mapped;
+    size_t  length;
     bool    freedoom;
     char    path[MAX_PATH];
     int     type;
@@ -62,6 +66,10 @@ wadfile_t *W_OpenFile(char *path);
 // Close the specified WAD file.
 void W_CloseFile(wadfile_t *wad);
 
+// Returns a pointer to the data at the specified offset from the start
+// of the file if the file is memory-mapped, or NULL otherwise.
+byte *W_MappedData(wadfile_t *wad, unsigned int offset, size_t length);
+
 // Read data from the specified file into the provided buffer. The
 // data is read from the specified offset from the start of the file.
 // Returns the number of bytes read.
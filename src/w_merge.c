@@ -62,6 +62,7 @@ typedef struct
     char                sprname[4];
     char                frame;
     lumpinfo_t          *angle_lumps[8];
+    int                 next;
 } sprite_frame_t;
 
 static searchlist_t     iwad;
@@ -77,6 +78,12 @@ static sprite_frame_t   *sprite_frames;
 static int              num_sprite_frames;
 static int              sprite_frames_alloced = 128;
 
+// sprite frames are also chained by name and frame, since every sprite lump
+// in both the IWAD and the PWAD is looked up at least once per merge
+#define SPRITEFRAMEHASHSIZE 1024
+
+static int              sprite_frame_hash[SPRITEFRAMEHASHSIZE];
+
 // Search in a list to find a lump with a particular name
 // Linear search (slow!)
 //
@@ -136,8 +143,22 @@ static void SetupLists(void)
 // Initialize the replace list
 static void InitSpriteList(void)
 {
+    Z_Free(sprite_frames);
     sprite_frames = Z_Malloc(sprite_frames_alloced * sizeof(*sprite_frames), PU_STATIC, NULL);
     num_sprite_frames = 0;
+
+    for (int i = 0; i < SPRITEFRAMEHASHSIZE; i++)
+        sprite_frame_hash[i] = -1;
+}
+
+static int SpriteFrameHash(const char *name, char frame)
+{
+    unsigned int    hash = (byte)frame;
+
+    for (int i = 0; i < 4; i++)
+        hash = hash * 31 + toupper(name[i]);
+
+    return (hash % SPRITEFRAMEHASHSIZE);
 }
 
 static bool ValidSpriteLumpName(char *name)
@@ -159,10 +180,11 @@ static bool ValidSpriteLumpName(char *name)
 // Find a sprite frame
 static sprite_frame_t *FindSpriteFrame(char *name, char frame)
 {
+    const int       hash = SpriteFrameHash(name, frame);
     sprite_frame_t  *result;
 
     // Search the list and try to find the frame
-    for (int i = 0; i < num_sprite_frames; i++)
+    for (int i = sprite_frame_hash[hash]; i >= 0; i = sprite_frames[i].next)
     {
         sprite_frame_t  *cur = &sprite_frames[i];
 
@@ -191,7 +213,8 @@ static sprite_frame_t *FindSpriteFrame(char *name, char frame)
     for (int i = 0; i < 8; i++)
         result->angle_lumps[i] = NULL;
 
-    num_sprite_frames++;
+    result->next = sprite_frame_hash[hash];
+    sprite_frame_hash[hash] = num_sprite_frames++;
 
     return result;
 }
@@ -258,17 +281,25 @@ static void AddSpriteLump(lumpinfo_t *lump)
         { "PLSG", "PLSF" }, { "BFGG", "BFGF" }, { "SAWG", ""     }, { "SHT2", "SHT2" }, { "",     ""     }
     };
 
-    sprite_frame_t  *sprite;
-    int             angle_num;
-    static int      MISFA0;
-    static int      MISFB0;
-    static int      SHT2A0;
-    static int      SHT2E0;
-    bool            isresourcewad = M_StringCompare(leafname(lump->wadfile->path), DOOMRETRO_RESOURCEWAD);
+    sprite_frame_t      *sprite;
+    int                 angle_num;
+    static int          MISFA0;
+    static int          MISFB0;
+    static int          SHT2A0;
+    static int          SHT2E0;
+    static wadfile_t    *wadfile;
+    static bool         isresourcewad;
 
     if (!ValidSpriteLumpName(lump->name))
         return;
 
+    // only compare the WAD's name when it changes from the previous lump's
+    if (lump->wadfile != wadfile)
+    {
+        wadfile = lump->wadfile;
+        isresourcewad = M_StringCompare(leafname(wadfile->path), DOOMRETRO_RESOURCEWAD);
+    }
+
     if (lump->wadfile->type == PWAD)
     {
         if (!isresourcewad)
@@ -88,101 +88,140 @@ char                *wadsloaded;
 static int          numwads;
 static wadfile_t    *wadlist[MAXWADS];
 
-static bool IsFreedoom(const char *iwadname)
+//
+// WAD directory cache
+//
+// A WAD is usually opened several times at startup to identify it, check
+// which IWAD it needs and whether it has a DEHACKED lump, before it is
+// finally added. So the header and directory of the last few WADs read are
+// kept, and reused for as long as the file's size and modification time
+// don't change.
+//
+#define WADDIRECTORIES  4
+
+typedef struct
 {
-    FILE        *fp = fopen(iwadname, "rb");
+    char        path[MAX_PATH];
+    int64_t     size;
+    time_t      modified;
     wadinfo_t   header;
-    int         result = false;
+    filelump_t  *lumps;
+} waddirectory_t;
 
-    if (!fp)
-        return false;
+static waddirectory_t   waddirectories[WADDIRECTORIES];
+static int              nextwaddirectory;
+
+static filelump_t *W_ReadDirectory(const char *filename, wadinfo_t *header)
+{
+    struct stat     status;
+    FILE            *fp;
+    waddirectory_t  *directory;
+    int             numlumps;
+
+    if (stat(filename, &status))
+        return NULL;
 
-    // read IWAD header
-    if (fread(&header, 1, sizeof(header), fp) == sizeof(header))
+    for (int i = 0; i < WADDIRECTORIES; i++)
     {
-        filelump_t  lump = { 0 };
-        const char  *n = lump.name;
+        directory = &waddirectories[i];
 
-        fseek(fp, LONG(header.infotableofs), SEEK_SET);
+        if (directory->lumps && M_StringCompare(directory->path, filename)
+            && directory->size == (int64_t)status.st_size && directory->modified == status.st_mtime)
+        {
+            *header = directory->header;
+            return directory->lumps;
+        }
+    }
 
-        for (int i = LONG(header.numlumps); i && fread(&lump, sizeof(lump), 1, fp); i--)
-            if (!strncmp(n, "FREEDOOM", 8))
-            {
-                result = true;
-                break;
-            }
+    if (!(fp = fopen(filename, "rb")))
+        return NULL;
+
+    if (fread(header, 1, sizeof(*header), fp) != sizeof(*header))
+    {
+        fclose(fp);
+        return NULL;
     }
 
+    directory = &waddirectories[nextwaddirectory];
+    nextwaddirectory = (nextwaddirectory + 1) % WADDIRECTORIES;
+
+    // read the whole directory at once, keeping however much of it is there
+    numlumps = MAX(0, LONG(header->numlumps));
+    free(directory->lumps);
+    directory->lumps = malloc(MAX(1, numlumps) * sizeof(filelump_t));
+
+    if (!directory->lumps || fseek(fp, LONG(header->infotableofs), SEEK_SET))
+        numlumps = 0;
+    else
+        numlumps = (int)fread(directory->lumps, sizeof(filelump_t), numlumps, fp);
+
     fclose(fp);
-    return result;
+
+    if (!directory->lumps)
+        return NULL;
+
+    header->numlumps = LONG(numlumps);
+    M_StringCopy(directory->path, filename, sizeof(directory->path));
+    directory->size = (int64_t)status.st_size;
+    directory->modified = status.st_mtime;
+    directory->header = *header;
+
+    return directory->lumps;
 }
 
-static bool IsBFGEdition(const char *iwadname)
+static bool IsFreedoom(const char *iwadname)
 {
-    FILE        *fp = fopen(iwadname, "rb");
     wadinfo_t   header;
-    int         result1 = false;
-    int         result2 = false;
+    filelump_t  *lumps = W_ReadDirectory(iwadname, &header);
 
-    if (!fp)
-        return false;
+    if (lumps)
+        for (int i = 0; i < LONG(header.numlumps); i++)
+            if (!strncmp(lumps[i].name, "FREEDOOM", 8))
+                return true;
 
-    // read IWAD header
-    if (fread(&header, 1, sizeof(header), fp) == sizeof(header))
-    {
-        filelump_t  lump = { 0 };
-        const char  *n = lump.name;
+    return false;
+}
 
-        fseek(fp, LONG(header.infotableofs), SEEK_SET);
+static bool IsBFGEdition(const char *iwadname)
+{
+    wadinfo_t   header;
+    filelump_t  *lumps = W_ReadDirectory(iwadname, &header);
+    bool        result1 = false;
+    bool        result2 = false;
 
-        for (int i = LONG(header.numlumps); i && fread(&lump, sizeof(lump), 1, fp); i--)
-            if (!strncmp(n, "DMENUPIC", 8))
-            {
-                result1 = true;
+    if (!lumps)
+        return false;
 
-                if (result2)
-                    break;
-            }
-            else if (!strncmp(n, "M_ACPT", 6))
-            {
-                result2 = true;
+    for (int i = 0; i < LONG(header.numlumps); i++)
+        if (!strncmp(lumps[i].name, "DMENUPIC", 8))
+        {
+            result1 = true;
 
-                if (result1)
-                    break;
-            }
-    }
+            if (result2)
+                break;
+        }
+        else if (!strncmp(lumps[i].name, "M_ACPT", 6))
+        {
+            result2 = true;
+
+            if (result1)
+                break;
+        }
 
-    fclose(fp);
     return (result1 && result2);
 }
 
 bool IsUltimateDOOM(const char *iwadname)
 {
-    FILE        *fp = fopen(iwadname, "rb");
     wadinfo_t   header;
-    int         result = false;
-
-    if (!fp)
-        return false;
-
-    // read IWAD header
-    if (fread(&header, 1, sizeof(header), fp) == sizeof(header))
-    {
-        filelump_t  lump = { 0 };
-        const char  *n = lump.name;
+    filelump_t  *lumps = W_ReadDirectory(iwadname, &header);
 
-        fseek(fp, LONG(header.infotableofs), SEEK_SET);
-
-        for (int i = LONG(header.numlumps); i && fread(&lump, sizeof(lump), 1, fp); i--)
-            if (!strncmp(n, "E4M1", 4))
-            {
-                result = true;
-                break;
-            }
-    }
+    if (lumps)
+        for (int i = 0; i < LONG(header.numlumps); i++)
+            if (!strncmp(lumps[i].name, "E4M1", 4))
+                return true;
 
-    fclose(fp);
-    return result;
+    return false;
 }
 
 char *GetCorrectCase(char *path)
@@ -294,7 +333,6 @@ bool W_AddFile(char *filename, bool autoloaded)
 {
     static bool resourcewadadded;
     wadinfo_t   header;
-    size_t      length;
     int         startlump;
     filelump_t  *fileinfo;
     filelump_t  *filerover;
@@ -323,10 +361,10 @@ bool W_AddFile(char *filename, bool autoloaded)
         REKKR = REKKRSA = true;
 
     // WAD file
-    W_Read(wadfile, 0, &header, sizeof(header));
+    fileinfo = W_ReadDirectory(filename, &header);
 
     // Homebrew levels?
-    if (strncmp(header.id, "IWAD", 4) && strncmp(header.id, "PWAD", 4))
+    if (!fileinfo || (strncmp(header.id, "IWAD", 4) && strncmp(header.id, "PWAD", 4)))
         I_Error("%s doesn't have an IWAD or PWAD id.", filename);
 
     if (!strncmp(header.id, "IWAD", 4) || D_IsDOOMIWAD(file))
@@ -338,10 +376,6 @@ bool W_AddFile(char *filename, bool autoloaded)
         wadfile->type = PWAD;
 
     header.numlumps = LONG(header.numlumps);
-    header.infotableofs = LONG(header.infotableofs);
-    length = header.numlumps * sizeof(filelump_t);
-    fileinfo = malloc(length);
-    W_Read(wadfile, header.infotableofs, fileinfo, length);
 
     // Increase size of numlumps array to accommodate the new file.
     filelumps = calloc(header.numlumps, sizeof(lumpinfo_t));
@@ -364,8 +398,6 @@ bool W_AddFile(char *filename, bool autoloaded)
         filerover++;
     }
 
-    free(fileinfo);
-
     if (!M_StringCompare(leafname(filename), DOOMRETRO_RESOURCEWAD) || devparm)
     {
         temp = commify((int64_t)numlumps - startlump);
@@ -588,84 +620,58 @@ unsigned int W_LumpNameHash(const char *s)
 
 bool HasDehackedLump(const char *pwadname)
 {
-    FILE        *fp = fopen(pwadname, "rb");
-    filelump_t  lump = { 0 };
     wadinfo_t   header;
-    const char  *n = lump.name;
-    int         result = false;
+    filelump_t  *lumps = W_ReadDirectory(pwadname, &header);
 
-    if (!fp)
-        return false;
-
-    // read IWAD header
-    if (fread(&header, 1, sizeof(header), fp) == sizeof(header))
-    {
-        fseek(fp, LONG(header.infotableofs), SEEK_SET);
+    if (lumps)
+        for (int i = 0; i < LONG(header.numlumps); i++)
+            if (!strncmp(lumps[i].name, "DEHACKED", 8))
+                return true;
 
-        for (int i = LONG(header.numlumps); i && fread(&lump, sizeof(lump), 1, fp); i--)
-            if (!strncmp(n, "DEHACKED", 8))
-            {
-                result = true;
-                break;
-            }
-    }
-
-    fclose(fp);
-    return result;
+    return false;
 }
 
 gamemission_t IWADRequiredByPWAD(char *pwadname)
 {
-    FILE            *fp = fopen(pwadname, "rb");
+    wadinfo_t       header;
+    filelump_t      *lumps = W_ReadDirectory(pwadname, &header);
     gamemission_t   result = none;
 
-    if (!fp)
+    if (!lumps)
         I_Error("Can't open PWAD: %s\n", pwadname);
+    else if (strncmp(header.id, "IWAD", 4) && strncmp(header.id, "PWAD", 4))
+        I_Error("%s doesn't have an IWAD or PWAD id.", pwadname);
     else
     {
-        wadinfo_t   header;
-
-        if (fread(&header, 1, sizeof(header), fp) != sizeof(header)
-            || (strncmp(header.id, "IWAD", 4) && strncmp(header.id, "PWAD", 4)))
-        {
-            fclose(fp);
-            I_Error("%s doesn't have an IWAD or PWAD id.", pwadname);
-        }
-        else
+        for (int i = 0; i < LONG(header.numlumps); i++)
         {
-            filelump_t  lump = { 0 };
-            const char  *n = lump.name;
-
-            fseek(fp, LONG(header.infotableofs), SEEK_SET);
-
-            for (int i = LONG(header.numlumps); (i && fread(&lump, sizeof(lump), 1, fp)); i--)
-                if (n[0] == 'E' && isdigit((int)n[1]) && n[2] == 'M' && isdigit((int)n[3]) && n[4] == '\0')
-                {
-                    result = doom;
-                    break;
-                }
-                else if (n[0] == 'M' && n[1] == 'A' && n[2] == 'P'
-                    && isdigit((int)n[3]) && isdigit((int)n[4]) && n[5] == '\0')
-                {
-                    result = doom2;
-                    break;
-                }
+            const char  *n = lumps[i].name;
 
-            fclose(fp);
-
-            if (result == doom2)
+            if (n[0] == 'E' && isdigit((int)n[1]) && n[2] == 'M' && isdigit((int)n[3]) && n[4] == '\0')
             {
-                char    *leaf = leafname(pwadname);
-
-                if (M_StringCompare(leaf, "pl2.wad")
-                    || M_StringCompare(leaf, "plut3.wad"))
-                    result = pack_plut;
-                else if (M_StringCompare(leaf, "tntr.wad")
-                    || M_StringCompare(leaf, "tnt-ren.wad")
-                    || M_StringCompare(leaf, "resist.wad"))
-                    result = pack_tnt;
+                result = doom;
+                break;
+            }
+            else if (n[0] == 'M' && n[1] == 'A' && n[2] == 'P'
+                && isdigit((int)n[3]) && isdigit((int)n[4]) && n[5] == '\0')
+            {
+                result = doom2;
+                break;
             }
         }
+
+        if (result == doom2)
+        {
+            char    *leaf = leafname(pwadname);
+
+            if (M_StringCompare(leaf, "pl2.wad")
+                || M_StringCompare(leaf, "plut3.wad"))
+                result = pack_plut;
+            else if (M_StringCompare(leaf, "tntr.wad")
+                || M_StringCompare(leaf, "tnt-ren.wad")
+                || M_StringCompare(leaf, "resist.wad"))
+                result = pack_tnt;
+        }
     }
 
     return result;
@@ -714,19 +720,79 @@ int W_WadType(char *filename)
 // just as much work as simply doing the string comparisons with the new
 // algorithm, which minimizes the expected number of comparisons to under 2.
 //
+// Lump names are now packed uppercase into 64 bits once, in W_Init(), so
+// only the name being looked up is packed on each search. Together with the
+// chains, they are kept in contiguous arrays rather than in each lumpinfo_t,
+// so every step along a chain is one integer compare within those arrays.
+//
+static uint64_t     *lumpnames;
+static int          *lumpchains;
+static int          *lumpnext;
+
+static uint64_t W_PackLumpName(const char *name)
+{
+    uint64_t    packed = 0;
+
+    for (int i = 0; i < 8 && name[i]; i++)
+        packed |= (uint64_t)(byte)toupper(name[i]) << (i * 8);
+
+    return packed;
+}
+
 int W_CheckNumForName(const char *name)
 {
+    const uint64_t  packed = W_PackLumpName(name);
+    int             i;
+
+    if (!lumpchains)
+    {
+        for (i = numlumps - 1; i >= 0; i--)
+            if (!strncasecmp(lumpinfo[i]->name, name, 8))
+                break;
+
+        return i;
+    }
+
     // Hash function maps the name to one of possibly numlump chains.
     // It has been tuned so that the average chain length never exceeds 2.
-    int i = lumpinfo[W_LumpNameHash(name) % numlumps]->index;
+    i = lumpchains[W_LumpNameHash(name) % numlumps];
 
-    while (i >= 0 && strncasecmp(lumpinfo[i]->name, name, 8))
-        i = lumpinfo[i]->next;
+    while (i >= 0 && lumpnames[i] != packed)
+        i = lumpnext[i];
 
     // Return the matching lump, or -1 if none found.
     return i;
 }
 
+//
+// W_PreviousNumForName
+// Returns the last lump before the given lump with the same name, or -1 if
+// there isn't one. Every lump with the same name is on the same hash chain,
+// in last-to-first order, so this is how all of them are found without
+// searching every lump.
+//
+static int W_PreviousNumForName(int lump)
+{
+    if (!lumpchains)
+    {
+        const char  *name = lumpinfo[lump]->name;
+
+        while (--lump >= 0)
+            if (!strncasecmp(lumpinfo[lump]->name, name, 8))
+                break;
+    }
+    else
+    {
+        const uint64_t  packed = lumpnames[lump];
+
+        do
+            lump = lumpnext[lump];
+        while (lump >= 0 && lumpnames[lump] != packed);
+    }
+
+    return lump;
+}
+
 //
 // W_CheckMultipleLumps
 // Check if there's more than one of the same lump.
@@ -738,30 +804,38 @@ int W_CheckMultipleLumps(const char *name)
     if (FREEDOOM || chex || hacx || harmony || REKKRSA)
         return 3;
 
-    for (int i = numlumps - 1; i >= 0; i--)
-        if (!strncasecmp(lumpinfo[i]->name, name, 8))
-            count++;
+    for (int i = W_CheckNumForName(name); i >= 0; i = W_PreviousNumForName(i))
+        count++;
 
     return count;
 }
 
 //
 // W_RangeCheckNumForName
-// Linear Search that checks for a lump number ONLY inside a range, not all lumps.
+// Checks for a lump number ONLY inside a range, not all lumps.
 //
 int W_RangeCheckNumForName(int min, int max, const char *name)
 {
-    for (int i = min; i <= max; i++)
-        if (!strncasecmp(lumpinfo[i]->name, name, 8))
-            return i;
+    int result = -1;
 
-    return -1;
+    for (int i = W_CheckNumForName(name); i >= min; i = W_PreviousNumForName(i))
+        if (i <= max)
+            result = i;
+
+    return result;
 }
 
 void W_Init(void)
 {
+    lumpnames = I_Realloc(lumpnames, numlumps * sizeof(*lumpnames));
+    lumpchains = I_Realloc(lumpchains, numlumps * sizeof(*lumpchains));
+    lumpnext = I_Realloc(lumpnext, numlumps * sizeof(*lumpnext));
+
     for (int i = 0; i < numlumps; i++)
-        lumpinfo[i]->index = -1;                       // mark slots empty
+    {
+        lumpnames[i] = W_PackLumpName(lumpinfo[i]->name);
+        lumpchains[i] = -1;                             // mark slots empty
+    }
 
     // Insert nodes to the beginning of each chain, in first-to-last
     // lump order, so that the last lump of a given name appears first
@@ -771,8 +845,8 @@ void W_Init(void)
         // hash function:
         const int   j = W_LumpNameHash(lumpinfo[i]->name) % numlumps;
 
-        lumpinfo[i]->next = lumpinfo[j]->index;       // Prepend to list
-        lumpinfo[j]->index = i;
+        lumpnext[i] = lumpchains[j];                    // Prepend to list
+        lumpchains[j] = i;
     }
 }
 
@@ -793,31 +867,47 @@ int W_GetNumForName(const char *name)
 // Go forwards rather than backwards so we get lump from IWAD and not PWAD
 int W_GetLastNumForName(const char *name)
 {
-    int i;
-
-    for (i = 0; i < numlumps; i++)
-        if (!strncasecmp(lumpinfo[i]->name, name, 8))
-            break;
+    int i = W_CheckNumForName(name);
 
-    if (i == numlumps)
+    if (i < 0)
         I_Error("W_GetLastNumForName: %s not found!", name);
 
+    for (int j = i; j >= 0; j = W_PreviousNumForName(j))
+        i = j;
+
     return i;
 }
 
 int W_GetSecondNumForName(const char *name)
 {
-    int count = 0;
-    int i;
+    int first = -1;
+    int second = -1;
 
-    for (i = 0; i < numlumps; i++)
-        if (!strncasecmp(lumpinfo[i]->name, name, 8) && ++count == 2)
-            break;
+    for (int i = W_CheckNumForName(name); i >= 0; i = W_PreviousNumForName(i))
+    {
+        second = first;
+        first = i;
+    }
 
-    if (i == numlumps)
+    if (second == -1)
         I_Error("W_GetSecondNumForName: %s not found!", name);
 
-    return i;
+    return second;
+}
+
+// Returns a patch's width from its header, without caching the whole patch.
+static short W_PatchWidth(int lump)
+{
+    lumpinfo_t  *l = lumpinfo[lump];
+    short       width = 0;
+
+    if (l->cache)
+        return SHORT(((patch_t *)l->cache)->width);
+
+    if (l->size >= (int)sizeof(width))
+        W_Read(l->wadfile, l->position, &width, sizeof(width));
+
+    return SHORT(width);
 }
 
 int W_GetWidestNumForName(const char *name)
@@ -825,11 +915,10 @@ int W_GetWidestNumForName(const char *name)
     int     i = -1;
     short   widest = 0;
 
-    for (int j = numlumps - 1; j >= 0; j--)
-        if (!strncasecmp(lumpinfo[j]->name, name, 8)
-            && (!M_StringEndsWith(lumpinfo[j]->wadfile->path, DOOMRETRO_RESOURCEWAD) || !widest))
+    for (int j = W_CheckNumForName(name); j >= 0; j = W_PreviousNumForName(j))
+        if (!M_StringEndsWith(lumpinfo[j]->wadfile->path, DOOMRETRO_RESOURCEWAD) || !widest)
         {
-            short   width = SHORT(((patch_t *)W_CacheLumpNum(j))->width);
+            short   width = W_PatchWidth(j);
 
             if (width > widest)
             {
@@ -872,19 +961,45 @@ static void W_ReadLump(int lump, void *dest)
         I_Error("W_ReadLump: only read %zd of %i on lump %i", c, l->size, lump);
 }
 
+//
+// W_CacheLumpNum
+// Returns the lump's data, locking it in memory until it is released as many
+// times as it has been cached. Released lumps stay cached, least recently
+// used first, until they no longer fit within the cachesize CVAR.
+//
 void *W_CacheLumpNum(int lumpnum)
 {
     lumpinfo_t  *lump = lumpinfo[lumpnum];
 
     if (!lump->cache)
-        W_ReadLump(lumpnum, Z_Malloc(lump->size, PU_CACHE, &lump->cache));
+    {
+        cachestats.misses++;
+
+        // use the lump in place if its WAD is memory-mapped
+        if ((lump->cache = W_MappedData(lump->wadfile, lump->position, lump->size)))
+            lump->mapped = true;
+        else
+            W_ReadLump(lumpnum, Z_Malloc(lump->size, PU_STATIC, &lump->cache));
+    }
+    else
+    {
+        cachestats.hits++;
+
+        if (!lump->mapped && !lump->locks)
+            Z_ChangeTag(lump->cache, PU_STATIC);
+    }
+
+    lump->locks++;
 
     return lump->cache;
 }
 
 void W_ReleaseLumpNum(int lumpnum)
 {
-    Z_ChangeTag(lumpinfo[lumpnum]->cache, PU_CACHE);
+    lumpinfo_t  *lump = lumpinfo[lumpnum];
+
+    if (lump->locks > 0 && !--lump->locks && !lump->mapped)
+        Z_ChangeTag(lump->cache, PU_CACHE);
 }
 
 void W_CloseFiles(void)
@@ -53,10 +53,8 @@
     char        name[9];
     int         size;
     void        *cache;
-
-    // killough 01/31/98: hash table fields, used for ultra-fast hash table lookup
-    int         index;
-    int         next;
+    bool        mapped;
+    int         locks;
 
     int         position;
 
@@ -34,6 +34,8 @@
 */
 
 #include "i_system.h"
+#include "m_config.h"
+#include "v_video.h"
 #include "z_zone.h"
 
 // Minimum chunk size at which blocks are allocated
@@ -46,6 +48,9 @@ typedef struct memblock_s
     size_t              size;
     void                **user;
     unsigned char       tag;
+    bool                arena;
+    slab_t              *slab;
+    zonecallsite_t      *callsite;
 } memblock_t;
 
 // size of block header
@@ -54,6 +59,261 @@ static const size_t headersize = ((sizeof(memblock_t) + CHUNK_SIZE - 1) & ~(CHUN
 
 static memblock_t   *blockbytag[PU_MAX];
 
+// PU_LEVEL and PU_LEVSPEC blocks are carved from large arenas by bumping a
+// pointer, so a level's many small allocations cost one malloc per arena
+// and are all freed together when the level ends. Blocks freed mid-level
+// are kept on free lists by size and reused. Larger blocks, and those with
+// a user, are still allocated individually.
+#define ARENA_SIZE          (1024 * 1024)
+#define ARENA_MAXBLOCKSIZE  4096
+
+typedef struct arena_s
+{
+    struct arena_s      *next;
+    size_t              used;
+} arena_t;
+
+static const size_t arenaheadersize = ((sizeof(arena_t) + CHUNK_SIZE - 1) & ~(CHUNK_SIZE - 1));
+
+static arena_t      *arenas[PU_MAX];
+static memblock_t   *arenafreelists[PU_MAX][ARENA_MAXBLOCKSIZE / CHUNK_SIZE + 1];
+
+// Slabs keep blocks of a single type together in arenas of their own,
+// SLAB_BLOCKS blocks at a time.
+#define SLAB_BLOCKS         128
+
+slab_t              *slabs;
+
+cachestats_t        cachestats;
+
+// When zoneaccounting is on, each block is also counted against the file,
+// line and tag it was allocated with.
+zonestats_t         zonestats[PU_MAX];
+bool                zoneaccounting;
+zonecallsite_t      zonecallsites[MAXCALLSITES];
+
+static zonecallsite_t *Z_GetCallsite(const char *file, int line, int tag)
+{
+    unsigned int    i = (unsigned int)((((uintptr_t)file >> 3) * 31 + line) * 31 + tag) % MAXCALLSITES;
+
+    for (int j = 0; j < MAXCALLSITES; j++, i = (i + 1) % MAXCALLSITES)
+    {
+        zonecallsite_t  *callsite = &zonecallsites[i];
+
+        if (!callsite->file)
+        {
+            callsite->file = file;
+            callsite->line = line;
+            callsite->tag = tag;
+            return callsite;
+        }
+
+        if (callsite->file == file && callsite->line == line && callsite->tag == tag)
+            return callsite;
+    }
+
+    return NULL;
+}
+
+static void Z_AccountTag(const memblock_t *block)
+{
+    zonestats_t *stats = &zonestats[block->tag];
+
+    stats->bytes += block->size;
+    stats->blocks++;
+
+    if (stats->bytes > stats->peakbytes)
+        stats->peakbytes = stats->bytes;
+
+    if (stats->blocks > stats->peakblocks)
+        stats->peakblocks = stats->blocks;
+}
+
+static void Z_UnaccountTag(const memblock_t *block)
+{
+    zonestats_t *stats = &zonestats[block->tag];
+
+    stats->bytes -= block->size;
+    stats->blocks--;
+}
+
+static void Z_Account(memblock_t *block, const char *file, int line)
+{
+    zonecallsite_t  *callsite = (zoneaccounting ? Z_GetCallsite(file, line, block->tag) : NULL);
+
+    Z_AccountTag(block);
+
+    if ((block->callsite = callsite))
+    {
+        callsite->bytes += block->size;
+        callsite->blocks++;
+
+        if (callsite->bytes > callsite->peakbytes)
+            callsite->peakbytes = callsite->bytes;
+    }
+}
+
+static void Z_Unaccount(const memblock_t *block)
+{
+    zonecallsite_t  *callsite = block->callsite;
+
+    Z_UnaccountTag(block);
+
+    if (callsite)
+    {
+        callsite->bytes -= block->size;
+        callsite->blocks--;
+    }
+}
+
+//
+// Z_EvictCacheBlock
+// Frees the least recently used PU_CACHE block. Blocks are appended to the
+// end of their tag's list whenever they are (re)tagged PU_CACHE, so the
+// oldest is always at its head.
+//
+static bool Z_EvictCacheBlock(void)
+{
+    memblock_t  *block = blockbytag[PU_CACHE];
+    void        *ptr;
+
+    if (!block)
+        return false;
+
+    ptr = (char *)block + headersize;
+    Z_Free(ptr);
+    cachestats.evictions++;
+
+    return true;
+}
+
+//
+// Z_TrimCache
+// Evicts PU_CACHE blocks until they fit within the cachesize CVAR, stopping
+// short of the given block if it is reached.
+//
+static void Z_TrimCache(const memblock_t *keep)
+{
+    const size_t    budget = (size_t)cachesize << 20;
+
+    while (cachestats.resident > budget && blockbytag[PU_CACHE] != keep && Z_EvictCacheBlock());
+}
+
+//
+// Z_ArenaMalloc
+// Allocates a block of the given rounded size from the tag's arenas.
+//
+static memblock_t *Z_ArenaMalloc(size_t size, int tag)
+{
+    memblock_t  **freelist = &arenafreelists[tag][size / CHUNK_SIZE];
+    memblock_t  *block = *freelist;
+
+    if (block)
+        *freelist = block->next;
+    else
+    {
+        arena_t *arena = arenas[tag];
+
+        if (!arena || arena->used + headersize + size > ARENA_SIZE)
+        {
+            while (!(arena = malloc(ARENA_SIZE)))
+                if (!Z_EvictCacheBlock())
+                    I_Error("Z_Malloc: Failure trying to allocate %lu bytes", (unsigned long)size);
+
+            arena->next = arenas[tag];
+            arena->used = arenaheadersize;
+            arenas[tag] = arena;
+        }
+
+        block = (memblock_t *)((char *)arena + arena->used);
+        arena->used += headersize + size;
+
+        block->size = size;
+        block->user = NULL;
+        block->tag = tag;
+        block->arena = true;
+        block->slab = NULL;
+    }
+
+    return block;
+}
+
+//
+// Z_FreeArenas
+// Frees a list of arenas of the given size, and every block in them, at once.
+//
+static void Z_FreeArenas(arena_t *arena, size_t size)
+{
+    while (arena)
+    {
+        arena_t *next = arena->next;
+
+        V_FreePatchDrawListsInRange(arena, (char *)arena + size);
+        free(arena);
+        arena = next;
+    }
+}
+
+//
+// Z_SlabMalloc
+// Allocates a block from a slab, reusing the most recently freed one if
+// there is one.
+//
+void *(Z_SlabMalloc)(slab_t *slab, const char *file, int line)
+{
+    memblock_t  *block = slab->freelist;
+
+    if (block)
+        slab->freelist = block->next;
+    else
+    {
+        arena_t *arena = slab->arenas;
+        size_t  arenasize;
+
+        // add the slab to the list the first time it is used
+        if (!slab->blocksize)
+        {
+            slab->blocksize = ((slab->size + CHUNK_SIZE - 1) & ~(CHUNK_SIZE - 1));
+            slab->next = slabs;
+            slabs = slab;
+        }
+
+        arenasize = arenaheadersize + SLAB_BLOCKS * (headersize + slab->blocksize);
+
+        if (!arena || arena->used == arenasize)
+        {
+            while (!(arena = malloc(arenasize)))
+                if (!Z_EvictCacheBlock())
+                    I_Error("Z_SlabMalloc: Failure trying to allocate %i %s blocks", SLAB_BLOCKS, slab->name);
+
+            arena->next = slab->arenas;
+            arena->used = arenaheadersize;
+            slab->arenas = arena;
+        }
+
+        block = (memblock_t *)((char *)arena + arena->used);
+        arena->used += headersize + slab->blocksize;
+
+        block->size = slab->blocksize;
+        block->user = NULL;
+        block->tag = slab->tag;
+        block->arena = true;
+        block->slab = slab;
+    }
+
+    if (++slab->live > slab->peak)
+        slab->peak = slab->live;
+
+    Z_Account(block, file, line);
+
+    return ((char *)block + headersize);
+}
+
+void *(Z_SlabCalloc)(slab_t *slab, const char *file, int line)
+{
+    return memset((Z_SlabMalloc)(slab, file, line), 0, slab->size);
+}
+
 //
 // Z_Malloc
 // You can pass a NULL user if the tag is < PU_PURGELEVEL.
@@ -66,7 +326,7 @@ static memblock_t   *blockbytag[PU_MAX];
 // but we only free the blocks we actually end up using; we don't
 // free all the stuff we just pass on the way.
 //
-void *Z_Malloc(size_t size, int tag, void **user)
+void *(Z_Malloc)(size_t size, int tag, void **user, const char *file, int line)
 {
     memblock_t  *block = NULL;
 
@@ -75,14 +335,18 @@ void *Z_Malloc(size_t size, int tag, void **user)
 
     size = ((size + CHUNK_SIZE - 1) & ~(CHUNK_SIZE - 1));   // round to chunk size
 
-    while (!(block = malloc(size + headersize)))
+    if ((tag == PU_LEVEL || tag == PU_LEVSPEC) && !user && size <= ARENA_MAXBLOCKSIZE)
     {
-        if (!blockbytag[PU_CACHE])
-            I_Error("Z_Malloc: Failure trying to allocate %lu bytes", (unsigned long)size);
+        block = Z_ArenaMalloc(size, tag);
+        Z_Account(block, file, line);
 
-        Z_FreeTags(PU_CACHE, PU_CACHE);
+        return ((char *)block + headersize);
     }
 
+    while (!(block = malloc(size + headersize)))
+        if (!Z_EvictCacheBlock())
+            I_Error("Z_Malloc: Failure trying to allocate %lu bytes", (unsigned long)size);
+
     if (!blockbytag[tag])
     {
         blockbytag[tag] = block;
@@ -100,6 +364,17 @@ void *Z_Malloc(size_t size, int tag, void **user)
 
     block->tag = tag;
     block->user = user;
+    block->arena = false;
+    block->slab = NULL;
+
+    Z_Account(block, file, line);
+
+    if (tag == PU_CACHE)
+    {
+        cachestats.resident += size;
+        Z_TrimCache(block);
+    }
+
     block = (memblock_t *)((char *)block + headersize);
 
     if (user)           // if there is a user
@@ -108,14 +383,14 @@ void *Z_Malloc(size_t size, int tag, void **user)
     return block;
 }
 
-void *Z_Calloc(size_t n1, size_t n2, int tag, void **user)
+void *(Z_Calloc)(size_t n1, size_t n2, int tag, void **user, const char *file, int line)
 {
-    return ((n1 *= n2) ? memset(Z_Malloc(n1, tag, user), 0, n1) : NULL);
+    return ((n1 *= n2) ? memset((Z_Malloc)(n1, tag, user, file, line), 0, n1) : NULL);
 }
 
-char *Z_StringDuplicate(const char *s, int tag, void **user)
+char *(Z_StringDuplicate)(const char *s, int tag, void **user, const char *file, int line)
 {
-    char    *d = Z_Malloc(strlen(s) + 1, tag, user);
+    char    *d = (Z_Malloc)(strlen(s) + 1, tag, user, file, line);
 
     if (d)
         strcpy(d, s);
@@ -132,10 +407,38 @@ void Z_Free(void *ptr)
 
     block = (memblock_t *)((char *)ptr - headersize);
 
+    // the block may have been drawn as a patch
+    V_FreePatchDrawLists(ptr);
+
+    Z_Unaccount(block);
+
+    // return slab and arena blocks to their free list for reuse
+    if (block->slab)
+    {
+        slab_t  *slab = block->slab;
+
+        block->next = slab->freelist;
+        slab->freelist = block;
+        slab->live--;
+        return;
+    }
+
+    if (block->arena)
+    {
+        memblock_t  **freelist = &arenafreelists[block->tag][block->size / CHUNK_SIZE];
+
+        block->next = *freelist;
+        *freelist = block;
+        return;
+    }
+
     // Nullify user if one exists
     if (block->user)
         *block->user = NULL;
 
+    if (block->tag == PU_CACHE)
+        cachestats.resident -= block->size;
+
     if (block == block->next)
         blockbytag[block->tag] = NULL;
     else if (blockbytag[block->tag] == block)
@@ -158,24 +461,47 @@ void Z_FreeTags(int lowtag, int hightag)
     for (; lowtag <= hightag; lowtag++)
     {
         memblock_t  *block = blockbytag[lowtag];
-        memblock_t  *end_block;
-
-        if (!block)
-            continue;
 
-        end_block = block->prev;
-
-        while (true)
+        if (block)
         {
-            memblock_t  *next = block->next;
+            memblock_t  *end_block = block->prev;
+
+            while (true)
+            {
+                memblock_t  *next = block->next;
 
-            Z_Free((char *)block + headersize);
+                Z_Free((char *)block + headersize);
 
-            if (block == end_block)
-                break;
+                if (block == end_block)
+                    break;
 
-            block = next;   // Advance to next block
+                block = next;   // Advance to next block
+            }
         }
+
+        Z_FreeArenas(arenas[lowtag], ARENA_SIZE);
+        arenas[lowtag] = NULL;
+        memset(arenafreelists[lowtag], 0, sizeof(arenafreelists[lowtag]));
+
+        for (slab_t *slab = slabs; slab; slab = slab->next)
+            if (slab->tag == lowtag)
+            {
+                Z_FreeArenas(slab->arenas, arenaheadersize + SLAB_BLOCKS * (headersize + slab->blocksize));
+                slab->arenas = NULL;
+                slab->freelist = NULL;
+                slab->live = 0;
+            }
+
+        // blocks in arenas aren't freed individually
+        zonestats[lowtag].bytes = 0;
+        zonestats[lowtag].blocks = 0;
+
+        for (int i = 0; i < MAXCALLSITES; i++)
+            if (zonecallsites[i].file && zonecallsites[i].tag == lowtag)
+            {
+                zonecallsites[i].bytes = 0;
+                zonecallsites[i].blocks = 0;
+            }
     }
 }
 
@@ -192,6 +518,9 @@ void Z_ChangeTag(void *ptr, int tag)
     if (tag == block->tag)
         return;
 
+    if (block->arena)
+        I_Error("Z_ChangeTag: Failure trying to change the tag of a block in an arena");
+
     if (block == block->next)
         blockbytag[block->tag] = NULL;
     else if (blockbytag[block->tag] == block)
@@ -213,5 +542,16 @@ void Z_ChangeTag(void *ptr, int tag)
         blockbytag[tag]->prev = block;
     }
 
+    if (block->tag == PU_CACHE)
+        cachestats.resident -= block->size;
+
+    Z_UnaccountTag(block);
     block->tag = tag;
+    Z_AccountTag(block);
+
+    if (tag == PU_CACHE)
+    {
+        cachestats.resident += block->size;
+        Z_TrimCache(NULL);
+    }
 }
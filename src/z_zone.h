@@ -58,9 +58,70 @@ enum
 
 #define PU_PURGELEVEL    PU_CACHE    // First purgeable tag's level
 
-void *Z_Malloc(size_t size, int tag, void **user) ALLOCATTR(1);
-void *Z_Calloc(size_t n1, size_t n2, int tag, void **user) ALLOCSATTR(1, 2);
-char *Z_StringDuplicate(const char *, int tag, void **user);
+typedef struct
+{
+    uint64_t    hits;
+    uint64_t    misses;
+    uint64_t    evictions;
+    size_t      resident;
+} cachestats_t;
+
+extern cachestats_t cachestats;
+
+// A slab keeps blocks of one type together, recycles them once they are
+// freed, and counts how many are live.
+typedef struct slab_s
+{
+    const char      *name;
+    size_t          size;
+    int             tag;
+
+    void            *arenas;
+    void            *freelist;
+    size_t          blocksize;
+    int             live;
+    int             peak;
+    struct slab_s   *next;
+} slab_t;
+
+extern slab_t       *slabs;
+
+typedef struct
+{
+    size_t          bytes;
+    size_t          peakbytes;
+    int             blocks;
+    int             peakblocks;
+} zonestats_t;
+
+typedef struct
+{
+    const char      *file;
+    int             line;
+    int             tag;
+    size_t          bytes;
+    size_t          peakbytes;
+    int             blocks;
+} zonecallsite_t;
+
+#define MAXCALLSITES    1024
+
+extern zonestats_t      zonestats[PU_MAX];
+extern bool             zoneaccounting;
+extern zonecallsite_t   zonecallsites[MAXCALLSITES];
+
+void *(Z_Malloc)(size_t size, int tag, void **user, const char *file, int line) ALLOCATTR(1);
+void *(Z_Calloc)(size_t n1, size_t n2, int tag, void **user, const char *file, int line) ALLOCSATTR(1, 2);
+void *(Z_SlabMalloc)(slab_t *slab, const char *file, int line);
+void *(Z_SlabCalloc)(slab_t *slab, const char *file, int line);
+char *(Z_StringDuplicate)(const char *s, int tag, void **user, const char *file, int line);
 void Z_Free(void *ptr);
 void Z_FreeTags(int lowtag, int hightag);
 void Z_ChangeTag(void *ptr, int tag);
+
+// Record the file and line of each allocation for zoneaccounting
+#define Z_Malloc(size, tag, user)           (Z_Malloc)(size, tag, user, __FILE__, __LINE__)
+#define Z_Calloc(n1, n2, tag, user)         (Z_Calloc)(n1, n2, tag, user, __FILE__, __LINE__)
+#define Z_SlabMalloc(slab)                  (Z_SlabMalloc)(slab, __FILE__, __LINE__)
+#define Z_SlabCalloc(slab)                  (Z_SlabCalloc)(slab, __FILE__, __LINE__)
+#define Z_StringDuplicate(s, tag, user)     (Z_StringDuplicate)(s, tag, user, __FILE__, __LINE__)